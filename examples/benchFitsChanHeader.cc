@@ -0,0 +1,94 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+Benchmark ways of loading a raw FITS header into a FitsChan:
+- reading it from a StringStream, one 80-character card at a time
+- FitsChan::putCards
+- FitsChan::putHeader
+
+Usage: benchFitsChanHeader [nHeaders [nCards]]
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "astshim.h"
+
+namespace {
+
+/// Make a FITS header of nCards cards plus an END card, padded to a whole number of 2880-byte blocks
+std::string makeHeader(int nCards) {
+    std::string header;
+    char card[81];
+    for (int i = 0; i < nCards; ++i) {
+        std::snprintf(card, sizeof(card), "KEY%-5d= %20.12f / comment for card %-30d", i, i * 0.125, i);
+        header += card;
+    }
+    std::snprintf(card, sizeof(card), "%-80s", "END");
+    header += card;
+    header.append((2880 - header.size() % 2880) % 2880, ' ');
+    return header;
+}
+
+/// Time nHeaders calls of loadHeader, which must return the number of cards loaded
+void bench(std::string const &name, int nHeaders, int nCards, std::function<int()> loadHeader) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nHeaders; ++i) {
+        if (loadHeader() != nCards) {
+            std::cerr << name << " loaded the wrong number of cards" << std::endl;
+            std::exit(1);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() * 1e6 / nHeaders << " us/header" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int const nHeaders = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int const nCards = argc > 2 ? std::atoi(argv[2]) : 200;
+    std::string const header = makeHeader(nCards);
+    std::cout << nHeaders << " headers of " << nCards << " cards" << std::endl;
+
+    bench("StringStream", nHeaders, nCards, [&header]() {
+        ast::StringStream stream(header);
+        ast::FitsChan fitsChan(stream);
+        return fitsChan.getNCard();
+    });
+    bench("putCards", nHeaders, nCards, [&header, nCards]() {
+        ast::StringStream stream;
+        ast::FitsChan fitsChan(stream);
+        // putCards would store the END card and padding, so pass only the cards
+        fitsChan.putCards(header.substr(0, nCards * 80));
+        return fitsChan.getNCard();
+    });
+    bench("putHeader", nHeaders, nCards, [&header]() {
+        ast::StringStream stream;
+        ast::FitsChan fitsChan(stream);
+        return fitsChan.putHeader(header.data(), header.size());
+    });
+}
@@ -0,0 +1,119 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+Benchmark transforming points with a FrameSet, which AST must search for and simplify the mapping
+from the base frame to the current frame on every call of astTranN:
+- a FrameSet with finite input, which is transformed with one call
+- a FrameSet with one nan input value, which is transformed in tiles of Mapping::TILE_NPOINTS points
+- the Mapping from FrameSet::getMapping with finite input, which is transformed in tiles
+
+Then compare the two ways Mapping::applyForward may call AST, using AST directly, for a FrameSet
+and for a ZoomMap, whose per-call cost is small:
+- in tiles, replacing AST__BAD with nan in the output of each tile while it is in the cache
+- with one call, then replacing AST__BAD with nan in a separate pass over the output
+
+Usage: benchFrameSetTran [nPoints [nCalls]]
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "astshim.h"
+#include "astshim/detail/utils.h"
+
+namespace {
+
+/// Time nCalls calls of transform
+void bench(std::string const &name, int nPoints, int nCalls, std::function<void()> transform) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nCalls; ++i) {
+        transform();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() * 1e9 / (static_cast<double>(nCalls) * nPoints)
+              << " ns/point" << std::endl;
+}
+
+/// Transform points forward with astTranN in tiles of tileNPoints points, replacing AST__BAD with nan
+void tranInTiles(ast::Mapping &mapping, ast::Array2D const &from, ast::Array2D const &to, int tileNPoints) {
+    int const nPoints = from.getSize<1>();
+    int const nIn = from.getSize<0>();
+    int const nOut = to.getSize<0>();
+    for (int tileBegin = 0; tileBegin < nPoints; tileBegin += tileNPoints) {
+        int const tileEnd = std::min(nPoints, tileBegin + tileNPoints);
+        astTranN(mapping.getRawPtr(), tileEnd - tileBegin, nIn, from.getStride<0>(),
+                 from.getData() + tileBegin, 1, nOut, to.getStride<0>(), to.getData() + tileBegin);
+        for (int axis = 0; axis < nOut; ++axis) {
+            double *toRow = to.getData() + axis * to.getStride<0>();
+            ast::detail::astBadToNan(toRow + tileBegin, toRow + tileEnd);
+        }
+    }
+    ast::assertOK();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int const nPoints = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int const nCalls = argc > 2 ? std::atoi(argv[2]) : 10;
+    std::cout << nCalls << " calls of " << nPoints << " points" << std::endl;
+
+    // a FrameSet with a few frames, so AST has a mapping to find and simplify
+    ast::Frame pixelFrame(2, "Domain=PIXELS");
+    ast::FrameSet frameSet(pixelFrame);
+    frameSet.addFrame(ast::FrameSet::CURRENT, ast::ShiftMap({-1000.0, -2000.0}),
+                      ast::Frame(2, "Domain=CENTERED"));
+    frameSet.addFrame(ast::FrameSet::CURRENT, ast::ZoomMap(2, 0.2), ast::Frame(2, "Domain=FOCAL"));
+    frameSet.addFrame(ast::FrameSet::CURRENT,
+                      ast::WinMap({-1.0, -1.0}, {1.0, 1.0}, {0.0, 0.0}, {2.0, 4.0}),
+                      ast::Frame(2, "Domain=NORMALIZED"));
+    auto mapping = frameSet.getMapping();
+
+    ast::Array2D from = ndarray::allocate(2, nPoints);
+    ast::Array2D fromWithNan = ndarray::allocate(2, nPoints);
+    for (int i = 0; i < nPoints; ++i) {
+        from[0][i] = fromWithNan[0][i] = i % 4000;
+        from[1][i] = fromWithNan[1][i] = i / 4000;
+    }
+    fromWithNan[0][nPoints / 2] = std::nan("");
+    ast::Array2D to = ndarray::allocate(2, nPoints);
+
+    bench("FrameSet", nPoints, nCalls, [&]() { frameSet.applyForward(from, to); });
+    bench("FrameSet with nan input", nPoints, nCalls, [&]() { frameSet.applyForward(fromWithNan, to); });
+    bench("FrameSet.getMapping()", nPoints, nCalls, [&]() { mapping->applyForward(from, to); });
+
+    int const tileNPoints = 4096;  // Mapping::TILE_NPOINTS
+    ast::ZoomMap zoomMap(2, 0.2);
+    for (ast::Mapping *tranMapping : std::vector<ast::Mapping *>{&frameSet, &zoomMap}) {
+        std::string const name = "astTranN on a " + tranMapping->getClassName();
+        bench(name + " in tiles", nPoints, nCalls,
+              [&]() { tranInTiles(*tranMapping, from, to, tileNPoints); });
+        bench(name + " in one call", nPoints, nCalls,
+              [&]() { tranInTiles(*tranMapping, from, to, nPoints); });
+    }
+}
@@ -9,6 +9,8 @@
 #include "astshim/MapSplit.h"
 #include "astshim/QuadApprox.h"
 #include "astshim/Mapping.h"
+#include "astshim/MappingPool.h"
+#include "astshim/CompiledMapping.h"
 #include "astshim/Frame.h"
 #include "astshim/FrameSet.h"
 #include "astshim/FrameDict.h"
@@ -16,6 +18,7 @@
 
 // channels
 #include "astshim/FitsChan.h"
+#include "astshim/FitsWcsWriter.h"
 #include "astshim/XmlChan.h"
 
 // frames
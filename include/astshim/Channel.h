@@ -65,7 +65,7 @@ public:
     Construct a channel that uses a provided @ref Stream
 
     @param[in] stream  Stream for channel I/O:
-        - For file I/O: provide a @ref FileStream
+        - For file I/O: provide a @ref FileStream, or to read a large file quickly, a @ref MmapStream
         - For string I/O (e.g. unit tests): provide a @ref StringStream
         - For standard I/O provide `Stream(&std::cin, &std::cout))`
             where either stream can be nullptr if not wanted
@@ -176,6 +176,13 @@ protected:
     */
     explicit Channel(AstChannel *chan);
 
+    /**
+    Write any buffered data to the stream and flush it
+
+    @return true on success, false if the stream is in a bad state after writing
+    */
+    bool flushStream() { return _stream.flush(); }
+
 private:
     Stream _stream;  ///< stream read and/or written read by the channel
 };
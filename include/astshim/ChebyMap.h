@@ -28,6 +28,7 @@
 
 #include "astshim/base.h"
 #include "astshim/Mapping.h"
+#include "astshim/detail/polyEvaluator.h"
 
 namespace ast {
 
@@ -93,9 +94,17 @@ All those of Mapping. In addition, the forward and inverse bounds can be retriev
 Strictly speaking, ChebyMap it has all the attributes of PolyMap, but the only attributes PolyMap adds
 to Mapping are iterative inverse parameters and those are ignored by ChebyMap because it does not (yet)
 support an iterative inverse.
+
+Transforms are evaluated by astshim rather than AST (see detail::PolyEvaluator), which is considerably
+faster for large numbers of points. Results agree with AST to within rounding error.
+The coefficients and domain of each transform are read from AST (the domain using astChebyDomain)
+when the transform is first used. For each block of points the evaluator fills a table of T_n(x)
+for each input axis using the recurrence T_n+1(x) = 2 x T_n(x) - T_n-1(x), then sums a list of
+the nonzero terms; it does not use Clenshaw's algorithm or a dense tensor of coefficients.
 */
 class ChebyMap : public Mapping {
     friend class Object;
+    friend class detail::TestAccess;
 
 public:
     /**
@@ -311,6 +320,17 @@ protected:
     /// Construct a ChebyMap from an raw AST pointer
     ChebyMap(AstChebyMap *map);
 
+    /// Transform points using detail::PolyEvaluator, if available for the requested transform
+    bool tranNative(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward, int nToAxes,
+                    int toStride, double *to) const override;
+
+    virtual void clearCache() override {
+        _evaluatorsReady = false;
+        _forwardEvaluator.reset();
+        _inverseEvaluator.reset();
+        Mapping::clearCache();
+    }
+
 private:
     /// Make a raw AstChebyMap with specified forward and inverse transforms.
     AstChebyMap *_makeRawChebyMap(ConstArray2D const &coeff_f, ConstArray2D const &coeff_i,
@@ -321,6 +341,16 @@ private:
     /// Make a raw AstChebyMap with a specified forward transform and an iterative inverse.
     AstChebyMap *_makeRawChebyMap(ConstArray2D const &coeff_f, int nout, std::vector<double> const &lbnd_f,
                                   std::vector<double> const &ubnd_f, std::string const &options = "") const;
+
+    /// Set _forwardEvaluator and _inverseEvaluator from the coefficients and domains
+    void _makeEvaluators() const;
+
+    // Evaluators for the forward and inverse transforms of the ChebyMap as constructed
+    // (ignoring Invert); null if that transform has no coefficients or must be evaluated by AST.
+    // They are made when first needed and reset by clearCache.
+    mutable bool _evaluatorsReady = false;
+    mutable std::shared_ptr<detail::PolyEvaluator const> _forwardEvaluator;
+    mutable std::shared_ptr<detail::PolyEvaluator const> _inverseEvaluator;
 };
 
 }  // namespace ast
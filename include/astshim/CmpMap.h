@@ -77,7 +77,8 @@ public:
     explicit CmpMap(Mapping const &map1, Mapping const &map2, bool series, std::string const &options = "")
             : Mapping(reinterpret_cast<AstMapping *>(astCmpMap(const_cast<AstObject *>(map1.getRawPtr()),
                                                                const_cast<AstObject *>(map2.getRawPtr()),
-                                                               series, "%s", options.c_str()))) {
+                                                               series, "%s", options.c_str()))),
+              _series(series) {
         assertOK();
     }
 
@@ -101,22 +102,42 @@ public:
     std::shared_ptr<Mapping> operator[](int i) const { return decompose<Mapping>(i, false); };
 
     /// Return True if the map is in series
-    bool getSeries() { return detail::isSeries(reinterpret_cast<AstCmpMap *>(getRawPtr())); }
+    bool getSeries() const { return _series; }
 
 protected:
+    /**
+    Tag for the constructors of SeriesMap and ParallelMap that do not check whether the CmpMap
+    is in series, for Object's type dispatch, which has already checked
+    */
+    struct SeriesChecked {};
+
     virtual std::shared_ptr<Object> copyPolymorphic() const override {
         return copyImpl<CmpMap, AstCmpMap>();
     }
 
     /// Construct a @ref CmpMap from a raw AST pointer
-    /// (protected instead of private so that SeriesMap and ParallelMap can call it)
-    explicit CmpMap(AstCmpMap *rawptr) : Mapping(reinterpret_cast<AstMapping *>(rawptr)) {
+    explicit CmpMap(AstCmpMap *rawptr) : CmpMap(rawptr, false) {
+        _series = detail::isSeries(rawptr);
+    }
+
+    /**
+    Construct a @ref CmpMap from a raw AST pointer, given whether it is in series
+
+    AST only reports whether a CmpMap is in series by decomposing it, so this saves the time
+    when the caller already knows (protected instead of private so that SeriesMap and ParallelMap
+    can call it).
+    */
+    explicit CmpMap(AstCmpMap *rawptr, bool series)
+            : Mapping(reinterpret_cast<AstMapping *>(rawptr)), _series(series) {
         if (!astIsACmpMap(getRawPtr())) {
             std::ostringstream os;
             os << "this is a " << getClassName() << ", which is not a CmpMap";
             throw std::invalid_argument(os.str());
         }
     }
+
+private:
+    bool _series;  // is this a series mapping? AST cannot change this after construction
 };
 
 }  // namespace ast
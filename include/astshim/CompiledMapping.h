@@ -0,0 +1,162 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef ASTSHIM_COMPILEDMAPPING_H
+#define ASTSHIM_COMPILEDMAPPING_H
+
+#include <memory>
+#include <vector>
+
+#include "ndarray.h"
+
+#include "astshim/base.h"
+#include "astshim/Mapping.h"
+
+namespace ast {
+
+/**
+A @ref Mapping flattened into a list of stages that are evaluated together, one tile of points at a time.
+
+AST transforms points through a compound mapping one component at a time, allocating intermediate
+arrays as large as the full set of points for each component. For a typical pixel to sky mapping
+(a @ref SeriesMap of, for instance, @ref ShiftMap, @ref MatrixMap, @ref PolyMap, @ref WcsMap
+and @ref SphMap) this makes the transformation of a large array of points limited by memory traffic.
+
+A CompiledMapping simplifies the mapping and flattens all nested @ref SeriesMap "SeriesMaps"
+into a list of stages, each a deep copy of one component. It then transforms points in tiles
+small enough to stay in cache, passing each tile through every stage before starting the next tile,
+so all intermediate arrays are tile-sized. @ref UnitMap "UnitMaps" are omitted
+and @ref ZoomMap "ZoomMaps" are evaluated directly rather than by AST;
+all other stages (including @ref ParallelMap "ParallelMaps") are evaluated one tile at a time
+in the same way as @ref Mapping.applyForward, e.g. by AST or, for @ref PolyMap, by astshim.
+
+As with @ref Mapping.applyForward, `nan` input values are treated as `AST__BAD`
+and `AST__BAD` output values are reported as `nan`.
+
+The stages are copied when the CompiledMapping is constructed, so later changes to the original mapping
+do not affect it. Like any AST object, a CompiledMapping may only be used by the thread that created it.
+
+@note CompiledMapping is a convenience class with no corresponding class in AST.
+*/
+class CompiledMapping {
+public:
+    /**
+    Construct a CompiledMapping
+
+    @param[in] mapping  Mapping to compile; a simplified version of it is flattened into stages
+    */
+    explicit CompiledMapping(Mapping const &mapping);
+
+    ~CompiledMapping() {}
+
+    CompiledMapping(CompiledMapping const &) = default;
+    CompiledMapping(CompiledMapping &&) = default;
+    CompiledMapping &operator=(CompiledMapping const &) = default;
+    CompiledMapping &operator=(CompiledMapping &&) = default;
+
+    /// Get the number of input axes of the mapping
+    int getNIn() const { return _nIn; }
+
+    /// Get the number of output axes of the mapping
+    int getNOut() const { return _nOut; }
+
+    /// Get the number of stages; this may be 0 if the simplified mapping is a UnitMap
+    int getNStages() const { return static_cast<int>(_stages.size()); }
+
+    /**
+    Perform a forward transformation on 2-D array, putting the results into a pre-allocated 2-D array
+
+    @param[in] from  input coordinates, with dimensions (nIn, nPts)
+    @param[out] to  transformed coordinates, with dimensions (nOut, nPts)
+    */
+    void applyForward(ConstArray2D const &from, Array2D const &to) const { _tran(from, true, to); }
+
+    /**
+    Perform a forward transformation on a 2-D array, returning the results as a new array
+
+    @param[in] from  input coordinates, with dimensions (nIn, nPts)
+    @return the results as a new array with dimensions (nOut, nPts)
+    */
+    Array2D applyForward(ConstArray2D const &from) const {
+        Array2D to = ndarray::allocate(getNOut(), from.getSize<1>());
+        _tran(from, true, to);
+        return to;
+    }
+
+    /**
+    Perform an inverse transformation on a 2-D array, putting the results into a pre-allocated 2-D array
+
+    @param[in] from  input coordinates, with dimensions (nOut, nPts)
+    @param[out] to  transformed coordinates, with dimensions (nIn, nPts)
+    */
+    void applyInverse(ConstArray2D const &from, Array2D const &to) const { _tran(from, false, to); }
+
+    /**
+    Perform an inverse transformation on a 2-D array, returning the results as a new 2-D array
+
+    @param[in] from  output coordinates, with dimensions (nOut, nPts)
+    @return the results as a new array with dimensions (nIn, nPts)
+    */
+    Array2D applyInverse(ConstArray2D const &from) const {
+        Array2D to = ndarray::allocate(getNIn(), from.getSize<1>());
+        _tran(from, false, to);
+        return to;
+    }
+
+private:
+    /// How a stage is evaluated
+    enum class StageKind {
+        AST,  ///< by AST
+        ZOOM  ///< by multiplying or dividing by a zoom factor
+    };
+
+    /// One stage of the compiled mapping
+    struct Stage {
+        std::shared_ptr<Mapping const> mapping;  ///< deep copy of the component mapping
+        int nIn;                                 ///< number of input axes of the component (forward)
+        int nOut;                                ///< number of output axes of the component (forward)
+        StageKind kind;
+        double zoom;        ///< zoom factor, if kind is ZOOM
+        bool zoomInverted;  ///< if kind is ZOOM: true if the forward transform divides by zoom
+    };
+
+    /*
+    Append the stages of a mapping, recursing into series compound mappings
+
+    @param[in] mapping  Mapping whose stages are to be added
+    @param[in] invert  Add the stages of the inverse of `mapping`?
+    */
+    void _addStages(Mapping const &mapping, bool invert);
+
+    /*
+    Implement applyForward and applyInverse, putting the results into a pre-allocated 2-D array.
+    */
+    void _tran(ConstArray2D const &from, bool doForward, Array2D const &to) const;
+
+    int _nIn;
+    int _nOut;
+    int _maxAxes;  // maximum number of axes of any input or output of any stage
+    std::vector<Stage> _stages;
+};
+
+}  // namespace ast
+
+#endif
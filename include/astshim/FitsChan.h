@@ -82,6 +82,20 @@ public:
     T value;     ///< The found value; ignore if `found` is false
 };
 
+/**
+The contents of all the cards in a @ref FitsChan, as parallel vectors in card order
+
+This is returned by @ref FitsChan.getAllCards "FitsChan::getAllCards".
+*/
+class FitsCards {
+public:
+    std::vector<std::string> names;     ///< keyword name of each card; may be empty for a comment card
+    std::vector<CardType> types;        ///< type of each card
+    std::vector<std::string> values;    ///< value of each card as a string; empty if the card has no value
+    std::vector<std::string> comments;  ///< comment of each card; empty if none
+    std::vector<std::string> cards;     ///< text of each card, as returned by @ref FitsChan.findFits
+};
+
 /**
 A specialized form of \ref Channel which reads and writes FITS header cards
 
@@ -205,7 +219,7 @@ public:
     Construct a channel that uses a provided @ref Stream
 
     @param[in] stream  Stream for channel I/O:
-        - For file I/O: provide a @ref FileStream
+        - For file I/O: provide a @ref FileStream, or to read a large file quickly, a @ref MmapStream
         - For string I/O (e.g. unit tests): provide a @ref StringStream
         - For standard I/O provide `Stream(&std::cin, &std::cout))`
             where either stream can be nullptr if not wanted
@@ -474,6 +488,34 @@ public:
     */
     std::vector<std::string> getAllCardNames();
 
+    /**
+    Get the text of all cards, in order, starting from the first card
+
+    This is the fastest way to get the whole header, as it reads each card with one call to AST.
+    The text of each card is as returned by @ref findFits.
+
+    Not "const" because the code changes the index of the current card while operating
+    (but restores the original index when done).
+    */
+    std::vector<std::string> getAllCardText();
+
+    /**
+    Get the name, type, value, comment and text of all cards, in order, starting from the first card
+
+    This walks through the cards once, so it is much faster than selecting each card in turn and calling
+    @ref getCardName, @ref getCardType, @ref getFitsS and @ref getCardComm for it.
+    It still makes several calls to AST per card, so if you only need the text of the cards
+    use @ref getAllCardText instead.
+
+    Values are as returned by @ref getFitsS (or @ref getFitsCN for CONTINUE cards),
+    so string values have no quotes, and are empty for cards with no value
+    (@ref CardType "types" COMMENT and UNDEF).
+
+    Not "const" because the code changes the index of the current card while operating
+    (but restores the original index when done).
+    */
+    FitsCards getAllCards();
+
     /**
     Get @ref FitsChan_AllWarnings "AllWarnings": a space separated list of
     all the conditions names recognized by the @ref FitsChan_Warnings "Warnings" attribute.
@@ -646,6 +688,27 @@ public:
         assertOK();
     }
 
+    /**
+    Replace all FITS header cards with those in a raw FITS header, such as an in-memory FITS HDU.
+
+    This is a faster alternative to @ref putCards or to reading the header from a @ref Stream:
+    each card is stored straight from the supplied buffer, so the header is neither copied
+    nor sourced one card at a time. The @ref FitsChan is "re-wound" on exit, as for @ref putCards.
+
+    @param[in] header  Pointer to the header: a sequence of 80-character cards with no delimiters.
+                    The cards are read up to the END card, if any, which is not stored;
+                    thus any padding following the END card (e.g. to fill a 2880-byte FITS block)
+                    is ignored.
+    @param[in] size  Size of the header, in bytes; must be a multiple of 80.
+    @return the number of cards stored
+
+    @throws std::invalid_argument if `size` is not a multiple of 80;
+        the @ref FitsChan is not changed.
+    @throws std::runtime_error if a card cannot be interpreted as a FITS header card;
+        the @ref FitsChan is left empty, since its original cards have already been discarded.
+    */
+    int putHeader(char const *header, std::size_t size);
+
     /**
     Read cards from the source and store them in the @ref FitsChan.
 
@@ -1024,7 +1087,11 @@ public:
     */
     void writeFits() {
         astWriteFits(getRawPtr());
+        bool isFlushed = flushStream();
         assertOK();
+        if (!isFlushed) {
+            throw std::runtime_error("Could not write to the stream of this channel");
+        }
     }
 
     /// Rewind the card index to the beginning
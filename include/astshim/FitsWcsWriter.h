@@ -0,0 +1,101 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef ASTSHIM_FITSWCSWRITER_H
+#define ASTSHIM_FITSWCSWRITER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "astshim/base.h"
+#include "astshim/FitsChan.h"
+#include "astshim/FrameSet.h"
+
+namespace ast {
+
+/**
+A prepared writer of FITS headers for many @ref FrameSet "FrameSets" with the same structure,
+e.g. the WCS of each CCD of a camera, which differ only in numeric parameters.
+
+The usual way to write such headers is to construct a @ref FitsChan for each @ref FrameSet,
+and perhaps try several encodings (or other options) until one succeeds.
+A FitsWcsWriter does that work once, for a template @ref FrameSet:
+- It parses the options once, and uses a single @ref FitsChan for all headers.
+- It tries the candidate encodings on the template, in order, and uses the first that succeeds
+    for all headers, with no further searching.
+
+AST itself offers no way to reuse its analysis of one @ref FrameSet for another,
+so each header is still written by AST in full, including the linearity tests
+controlled by @ref FitsChan_FitsTol "FitsTol"; if a @ref FrameSet cannot be written
+with the chosen encoding then @ref write throws, rather than trying other encodings.
+
+Like any AST object, a FitsWcsWriter may only be used by the thread that created it.
+
+@note FitsWcsWriter is a convenience class with no corresponding class in AST.
+*/
+class FitsWcsWriter {
+public:
+    /**
+    Construct a FitsWcsWriter from a template FrameSet
+
+    @param[in] templ  Template FrameSet: a FrameSet with the same structure as those to be written
+    @param[in] encodings  Encodings to try, in order of preference; see
+        @ref FitsChan_Encoding "Encoding" for the supported values.
+    @param[in] options  Other options for the @ref FitsChan, as a comma-separated list
+        of attribute assignments (e.g. "CDMatrix=1, SipOK=1"); must not set Encoding.
+
+    @throws std::invalid_argument if `encodings` is empty, if `options` sets Encoding,
+        or if `templ` cannot be written with any of the encodings.
+    */
+    explicit FitsWcsWriter(FrameSet const &templ,
+                           std::vector<std::string> const &encodings = {"FITS-WCS"},
+                           std::string const &options = "");
+
+    ~FitsWcsWriter() {}
+
+    FitsWcsWriter(FitsWcsWriter const &) = delete;
+    FitsWcsWriter(FitsWcsWriter &&) = delete;
+    FitsWcsWriter &operator=(FitsWcsWriter const &) = delete;
+    FitsWcsWriter &operator=(FitsWcsWriter &&) = delete;
+
+    /// Get the encoding used for all headers: the first candidate encoding that succeeded for the template
+    std::string getEncoding() const { return _encoding; }
+
+    /**
+    Write a FrameSet as a FITS header
+
+    @param[in] frameSet  FrameSet to write; should have the same structure as the template
+    @return the FITS header cards, each padded to 80 characters, with no delimiters between them;
+        this is the format accepted by @ref FitsChan.putCards.
+
+    @throws std::runtime_error if `frameSet` cannot be written with the chosen encoding.
+    */
+    std::string write(FrameSet const &frameSet);
+
+private:
+    std::unique_ptr<FitsChan> _fitsChan;  ///< FitsChan used to write all headers; emptied after each use
+    std::string _encoding;                ///< encoding used for all headers
+};
+
+}  // namespace ast
+
+#endif
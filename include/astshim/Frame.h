@@ -205,6 +205,21 @@ public:
         return detail::safeDouble(astAngle(getRawPtr(), a.data(), b.data(), c.data()));
     }
 
+    /**
+    Variant of @ref angle(PointD const &, PointD const &, PointD const &) const "angle"
+    for many sets of points
+
+    @param[in] a  the coordinates of the first points, with dimensions (nAxes, nPoints)
+    @param[in] b  the coordinates of the second points, with dimensions (nAxes, nPoints)
+    @param[in] c  the coordinates of the third points, with dimensions (nAxes, nPoints)
+
+    @return The angle at each point of `b`, as for the single point version.
+
+    @throws std::invalid_argument if `a`, `b` or `c` have the wrong number of axes or a different
+        number of points
+    */
+    Array1D angle(ConstArray2D const &a, ConstArray2D const &b, ConstArray2D const &c) const;
+
     /**
     Find the angle, as seen from point A, between the positive direction of a specified axis,
     and the geodesic curve joining point A to point B.
@@ -232,6 +247,21 @@ public:
         return detail::safeDouble(astAxAngle(getRawPtr(), a.data(), b.data(), axis));
     }
 
+    /**
+    Variant of @ref axAngle(PointD const &, PointD const &, int) const "axAngle" for many pairs of points
+
+    @param[in] a  the coordinates of the first points, with dimensions (nAxes, nPoints)
+    @param[in] b  the coordinates of the second points, with dimensions (nAxes, nPoints)
+    @param[in] axis  the index of the axis from which the angles are to be measured,
+        where 1 is the first axis
+
+    @return The angle for each pair of points, as for the single point version.
+
+    @throws std::invalid_argument if `a` or `b` have the wrong number of axes or a different
+        number of points
+    */
+    Array1D axAngle(ConstArray2D const &a, ConstArray2D const &b, int axis) const;
+
     /**
     Return a signed value representing the axis increment from axis value v1 to axis value v2.
 
@@ -477,6 +507,22 @@ public:
         return detail::safeDouble(astDistance(getRawPtr(), point1.data(), point2.data()));
     }
 
+    /**
+    Variant of @ref distance(PointD const &, PointD const &) const "distance" for many pairs of points
+
+    This makes one call to AST per pair of points, but allocates no memory per pair,
+    so it is much faster than calling the single point version in a loop.
+
+    @param[in] points1  The coordinates of the first points, with dimensions (nAxes, nPoints).
+    @param[in] points2  The coordinates of the second points, with dimensions (nAxes, nPoints).
+
+    @return The distance between each pair of points.
+
+    @throws std::invalid_argument if `points1` or `points2` have the wrong number of axes
+        or a different number of points
+    */
+    Array1D distance(ConstArray2D const &points1, ConstArray2D const &points2) const;
+
     /**
     Find a coordinate system with specified characteristics.
 
@@ -1049,6 +1095,16 @@ public:
         return value;
     }
 
+    /**
+    Variant of @ref norm(PointD) const "norm" for many points, which normalises the points in place
+
+    @param[in,out] values  Points in the space which the Frame describes, with dimensions (nAxes, nPoints).
+        Each point is replaced by its normalised version.
+
+    @throws std::invalid_argument if `values` has the wrong number of axes
+    */
+    void norm(Array2D const &values) const;
+
     /**
     Find the point which is offset a specified distance along the geodesic curve between two other points.
 
@@ -1082,6 +1138,23 @@ public:
         return ret;
     }
 
+    /**
+    Variant of @ref offset(PointD, PointD, double) const "offset" for many pairs of points
+
+    @param[in] points1  The points marking the start of each geodesic curve,
+        with dimensions (nAxes, nPoints).
+    @param[in] points2  The points marking the end of each geodesic curve,
+        with dimensions (nAxes, nPoints).
+    @param[in] offsets  The required offset from each point of `points1` along its geodesic curve,
+        as for the single point version.
+
+    @return the offset points, with dimensions (nAxes, nPoints)
+
+    @throws std::invalid_argument if `points1`, `points2` or `offsets` have the wrong number of axes
+        or a different number of points
+    */
+    Array2D offset(ConstArray2D const &points1, ConstArray2D const &points2, ConstArray1D const &offsets) const;
+
     /**
     Find the point which is offset a specified distance along the geodesic curve at a given angle
     from a specified starting point. This can only be used with 2-dimensional Frames.
@@ -1124,6 +1197,24 @@ public:
         return DirectionPoint(detail::safeDouble(offsetAngle), point2);
     }
 
+    /**
+    Variant of @ref offset2(PointD const &, double, double) const "offset2" for many points,
+    which writes the results to output arrays
+
+    @param[in] points1  The points marking the start of each geodesic curve, with dimensions (2, nPoints).
+    @param[in] angles  The angle (in radians) of each geodesic curve, as for the single point version.
+    @param[in] offsets  The required offset along each geodesic curve, as for the single point version.
+    @param[out] directions  The direction of each geodesic curve at its end point,
+        as for the single point version.
+    @param[out] points2  The offset points, with dimensions (2, nPoints).
+
+    @throws std::invalid_argument if
+    - frame does not have naxes = 2
+    - any argument has the wrong number of axes or a different number of points
+    */
+    void offset2(ConstArray2D const &points1, ConstArray1D const &angles, ConstArray1D const &offsets,
+                 Array1D const &directions, Array2D const &points2) const;
+
     /**
     Permute the order in which a Frame's axes occur
 
@@ -1541,6 +1632,24 @@ private:
             throw std::invalid_argument(os.str());
         }
     }
+
+    /**
+    Assert that an array of points has the right number of axes and points
+
+    @param[in] points  The points to check, with dimensions (nAxes, nPoints)
+    @param[in] name  Name of the array to use in an error message
+    @param[in] nPoints  Required number of points
+    */
+    template <typename T>
+    void assertPointsShape(T const &points, char const *name, std::size_t nPoints) const {
+        if (static_cast<int>(points.template getSize<0>()) != getNIn()) {
+            std::ostringstream os;
+            os << name << " has " << points.template getSize<0>() << " axes, but " << getNIn() << " required";
+            throw std::invalid_argument(os.str());
+        }
+        detail::assertEqual(points.template getSize<1>(), std::string(name) + ".size[1]", nPoints,
+                            "number of points");
+    }
 };
 
 }  // namespace ast
@@ -127,6 +127,8 @@ public:
 
     @throws std::invalid_argument if `frame` has a non-empty domain and this FrameDict already
     contains a Frame with that domain
+    @throws std::runtime_error if the change fails and cannot be undone,
+    in which case this FrameDict is left inconsistent
     */
     void addFrame(int iframe, Mapping const &map, Frame const &frame) override;
 
@@ -152,6 +154,17 @@ public:
         return getFrame(getIndex(domain), copy);
     }
 
+    using FrameSet::getFrameView;
+
+    /**
+    Variant of @ref FrameSet::getFrameView where the frame is specified by domain name.
+
+    @throw std::out_of_range if no frame found with the specified domain
+    */
+    std::shared_ptr<Frame const> getFrameView(std::string const &domain) const {
+        return getFrameView(getIndex(domain));
+    }
+
     using FrameSet::getMapping;
 
     /**
@@ -181,6 +194,35 @@ public:
         return getMapping(getIndex(from), getIndex(to));
     }
 
+    using FrameSet::getMappingView;
+
+    /**
+    Variant of @ref FrameSet::getMappingView with the second frame specified by domain.
+
+    @throw std::out_of_range if no frame found with the specified from or to domain
+    */
+    std::shared_ptr<Mapping const> getMappingView(int from, std::string const &to) const {
+        return getMappingView(from, getIndex(to));
+    }
+
+    /**
+    Variant of @ref FrameSet::getMappingView with the first frame specified by domain.
+
+    @throw std::out_of_range if no frame found with the specified from or to domain
+    */
+    std::shared_ptr<Mapping const> getMappingView(std::string const &from, int to) const {
+        return getMappingView(getIndex(from), to);
+    }
+
+    /**
+    Variant of @ref FrameSet::getMappingView with the both frames specified by domain.
+
+    @throw std::out_of_range if no frame found with the specified from or to domain
+    */
+    std::shared_ptr<Mapping const> getMappingView(std::string const &from, std::string const &to) const {
+        return getMappingView(getIndex(from), getIndex(to));
+    }
+
     /**
     Get the index of a frame specified by domain
 
@@ -198,7 +240,9 @@ public:
     /**
     Return True if a frame in this FrameDict has the specified domain
     */
-    bool hasDomain(std::string const &domain) const { return _domainIndexDict.count(domain) > 0; }
+    bool hasDomain(std::string const &domain) const {
+        return _domainIndexDict.count(detail::stringToUpper(domain)) > 0;
+    }
 
     using FrameSet::mirrorVariants;
 
@@ -250,6 +294,8 @@ public:
     Set the domain of the current frame (and update the internal dict).
 
     @throws std::invalid_argument if another frame already has this domain
+    @throws std::runtime_error if the change fails and cannot be undone,
+    in which case this FrameDict is left inconsistent
     */
     void setDomain(std::string const &domain) override;
 
@@ -261,11 +307,6 @@ protected:
     /**
     Return a deep copy as a FrameSet
 
-    This is used internally for operations that modify the contents:
-    - Retrieve a copy as a FrameSet
-    - Modify the copy
-    - Call _update to construct a new domain:index dict from the copy and swap in the new data
-
     This could be a public member function, but wait until a need is identified.
 
     Warning: this must return a FrameSet, not a FrameDict in order to avoid an infinite loop.
@@ -283,19 +324,6 @@ private:
     */
     static std::unordered_map<std::string, int> _makeNewDict(FrameSet const &frameSet);
 
-    /*
-    Update the internal data using the supplied frameSet, which is swapped with the old data.
-
-    Build a new domain::index dict from frameSet. If successful, replace the current dict
-    and swap frameSet with the old frame set data.
-
-    If any exception is thrown this FrameDict (and the frameSet argument) is unchanged.
-    */
-    void _update(FrameSet &frameSet) {
-        _domainIndexDict = _makeNewDict(frameSet);
-        this->swapRawPointers(frameSet);
-    }
-
     std::unordered_map<std::string, int> _domainIndexDict;  // Dict of frame domain:index
 };
 
@@ -25,6 +25,8 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "astshim/base.h"
 #include "astshim/Frame.h"
@@ -104,6 +106,7 @@ public:
     static int constexpr BASE = AST__BASE;        ///< index of base frame
     static int constexpr CURRENT = AST__CURRENT;  ///< index of current frame
     static int constexpr NOFRAME = AST__NOFRAME;  ///< an invalid frame index
+    static int constexpr MAPPING_CACHE_SIZE = 8;  ///< maximum number of mappings cached by getMapping
     /**
     Construct a FrameSet from a Frame
 
@@ -268,6 +271,9 @@ public:
     by getFrame) as this will not affect the connected mappings.
     */
     std::shared_ptr<Frame> getFrame(int iframe, bool copy = true) const {
+        if (!copy) {
+            preventSharing();
+        }
         auto *rawFrame = reinterpret_cast<AstObject *>(astGetFrame(getRawPtr(), iframe));
         assertOK(rawFrame);
         if (!rawFrame) {
@@ -276,6 +282,20 @@ public:
         return Object::fromAstObject<Frame>(rawFrame, copy);
     }
 
+    /**
+    Get a read-only view of a @ref Frame in this @ref FrameSet, without copying it
+
+    This is @ref getFrame "getFrame(iframe, false)" with a const result, for callers that only
+    need to read the frame. The view shares the frame in this FrameSet, so it shows any later
+    changes made through the FrameSet; call @ref getFrame for an independent copy.
+
+    @param[in] iframe  The index of the required @ref Frame within this @ref FrameSet.
+        This value should lie in the range 1 to the number of frames already in this @ref FrameSet
+        (as given by @ref getNFrame). A value of FrameSet::BASE or FrameSet::CURRENT
+        may be given to specify the base @ref Frame or the current @ref Frame, respectively.
+    */
+    std::shared_ptr<Frame const> getFrameView(int iframe) const { return getFrame(iframe, false); }
+
     /**
     Obtain a @ref Mapping that converts between two @ref Frame "Frames" in a @ref FrameSet
 
@@ -300,15 +320,31 @@ public:
         necessarily guarantee that it will be able to perform the required coordinate conversion.
         If necessary, call `hasForward` or `hasInverse` on the returned @ref Mapping
         to determine if the required transformation is available.
+    - If the mapping cache is enabled (see @ref setMappingCacheEnabled) then asking for a recently
+        requested pair of frames again only costs a copy of the cached @ref Mapping.
     */
-    std::shared_ptr<Mapping> getMapping(int from = BASE, int to = CURRENT) const {
-        AstObject *rawMap = reinterpret_cast<AstObject *>(astGetMapping(getRawPtr(), from, to));
-        assertOK(rawMap);
-        if (!rawMap) {
-            throw std::runtime_error("getMapping failed (returned a null mapping)");
-        }
-        return Object::fromAstObject<Mapping>(rawMap, true);
-    }
+    std::shared_ptr<Mapping> getMapping(int from = BASE, int to = CURRENT) const;
+
+    /**
+    Get a read-only view of the @ref Mapping that converts between two @ref Frame "Frames",
+    without copying it
+
+    This is the @ref Mapping that AST finds, returned as is rather than copied; it may share
+    its component mappings with this FrameSet. Use it when the @ref Mapping is only used
+    to transform points, to avoid copying large mappings such as a @ref PolyMap
+    with many coefficients or a @ref LutMap with a long table.
+    The view is a snapshot: it is not affected by later changes to this FrameSet.
+    If the mapping cache is enabled (see @ref setMappingCacheEnabled) then the view is cached.
+
+    @param[in] from   The index of the first @ref Frame, as for @ref getMapping.
+    @param[in] to   The index of the second @ref Frame, as for @ref getMapping.
+    */
+    std::shared_ptr<Mapping const> getMappingView(int from = BASE, int to = CURRENT) const;
+
+    /**
+    Is the mapping cache enabled? See @ref setMappingCacheEnabled
+    */
+    bool getMappingCacheEnabled() const { return _mappingCacheEnabled; }
 
     /**
     Get FrameSet_NFrame "NFrame": number of @ref Frame "Frames" in the @ref FrameSet, starting from 1
@@ -475,11 +511,36 @@ public:
     */
     void setCurrent(int ind) { setI("Current", ind); }
 
+    /**
+    Enable or disable caching of the mappings found by @ref getMapping and @ref getMappingView
+
+    The cache is disabled by default. When it is enabled, the @ref Mapping for each of the last
+    @ref MAPPING_CACHE_SIZE pairs of frames requested is kept, so asking for one of those pairs again
+    does not make AST find and simplify the mapping again. This helps code that asks for the same
+    mapping in a loop. The cache is emptied whenever this FrameSet is modified, and when it is disabled.
+
+    This setting is not an AST attribute, so it is not saved when the FrameSet is written.
+    */
+    void setMappingCacheEnabled(bool enable) {
+        _mappingCacheEnabled = enable;
+        if (!enable) {
+            _mappingCache.clear();
+        }
+    }
+
 protected:
     virtual std::shared_ptr<Object> copyPolymorphic() const override {
         return copyImpl<FrameSet, AstFrameSet>();
     }
 
+    virtual void clearCache() override {
+        _mappingCache.clear();
+        Frame::clearCache();
+    }
+
+    /// Each call of astTranN on a FrameSet finds and simplifies the mapping from base to current frame
+    virtual bool hasCostlyTranCall() const override { return true; }
+
     /**
     Construct a FrameSet from a raw AST pointer
 
@@ -506,6 +567,14 @@ private:
         assertOK();
     }
 
+    // Find the mapping between two frames; the caller owns the returned AST object
+    AstObject *_getRawMapping(int from, int to) const;
+
+    bool _mappingCacheEnabled = false;
+    // Mappings found by getMappingView, by (from, to) frame index with BASE and CURRENT resolved,
+    // oldest first; at most MAPPING_CACHE_SIZE of them. These are never modified; getMapping returns copies.
+    // See clearCache for how the cache is kept up to date.
+    mutable std::vector<std::pair<std::pair<int, int>, std::shared_ptr<Mapping const>>> _mappingCache;
 };
 
 }  // namespace ast
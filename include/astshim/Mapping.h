@@ -33,6 +33,7 @@
 
 namespace ast {
 
+class CompiledMapping;
 class ParallelMap;
 class SeriesMap;
 
@@ -43,6 +44,10 @@ Mapping is used to describe the relationship which exists between two different
 coordinate systems and to implement operations which make use of
 this (such as transforming coordinates and resampling grids of data).
 
+When transforming points (@ref applyForward and @ref applyInverse), `nan` input values
+are treated as `AST__BAD`, so any output coordinate that depends on them is `AST__BAD`,
+which (by default) is reported as `nan`.
+
 ### Attributes
 
 In addition to those attributes common to @ref Object,
@@ -58,6 +63,8 @@ Mapping also has the following attributes:
 */
 class Mapping : public Object {
     friend class Object;
+    friend class CompiledMapping;
+    friend class MappingPool;
 
 public:
     virtual ~Mapping() {}
@@ -73,13 +80,27 @@ public:
 
     /**
     Get @ref Mapping_NIn "NIn": the number of input axes
+
+    The value is cached, since it is needed for nearly every transform.
     */
-    int getNIn() const { return getI("NIn"); }
+    int getNIn() const {
+        if (_nIn < 0) {
+            _nIn = getI("NIn");
+        }
+        return _nIn;
+    }
 
     /**
     Get @ref Mapping_NOut "NOut": the number of output axes
+
+    The value is cached, since it is needed for nearly every transform.
     */
-    int getNOut() const { return getI("NOut"); }
+    int getNOut() const {
+        if (_nOut < 0) {
+            _nOut = getI("NOut");
+        }
+        return _nOut;
+    }
 
     /**
     Get @ref Mapping_IsSimple "IsSimple": has the mapping been simplified?
@@ -92,7 +113,12 @@ public:
     Note: this gets the @ref Mapping_Invert "Invert" attribute.
     This method is not called `getInvert` because that sounds like it might return the inverse.
     */
-    bool isInverted() const { return getB("Invert"); }
+    bool isInverted() const {
+        if (_isInverted < 0) {
+            _isInverted = getB("Invert");
+        }
+        return _isInverted;
+    }
 
     /**
     Get @ref Mapping_IsLinear "IsLinear": is the Mapping linear?
@@ -163,6 +189,14 @@ public:
     */
     Array2D linearApprox(PointD const &lbnd, PointD const &ubnd, double tol) const;
 
+    /**
+    Return a @ref CompiledMapping that transforms points using a flattened, simplified copy of this mapping
+
+    This is more efficient than @ref applyForward and @ref applyInverse for compound mappings
+    and large numbers of points; see @ref CompiledMapping for details.
+    */
+    CompiledMapping compiled() const;
+
     /**
     Return a series compound mapping this(first(input)) containing shallow copies of the original
 
@@ -256,18 +290,53 @@ public:
 
     @param[in] from  input coordinates, with dimensions (nPts, nIn)
     @param[out] to  transformed coordinates, with dimensions (nPts, nOut)
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
     */
-    void applyForward(ConstArray2D const &from, Array2D const &to) const { _tran(from, true, to); }
+    void applyForward(ConstArray2D const &from, Array2D const &to, bool badToNan = true) const {
+        _tran(from, true, to, badToNan);
+    }
 
     /**
     Perform a forward transformation on a 2-D array, returning the results as a new array
 
     @param[in] from  input coordinates, with dimensions (nPts, nIn)
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
     @return the results as a new array with dimensions (nPts, nOut)
     */
-    Array2D applyForward(ConstArray2D const &from) const {
+    Array2D applyForward(ConstArray2D const &from, bool badToNan = true) const {
         Array2D to = ndarray::allocate(getNOut(), from.getSize<1>());
-        _tran(from, true, to);
+        _tran(from, true, to, badToNan);
+        return to;
+    }
+
+    /**
+    Perform a forward transformation on a 2-D array, putting the results into a pre-allocated 2-D array
+    and reporting which points could be transformed
+
+    @param[in] from  input coordinates, with dimensions (nPts, nIn)
+    @param[out] to  transformed coordinates, with dimensions (nPts, nOut)
+    @param[out] isValid  pre-allocated array of nPts flags, each set true if all output coordinates
+        for that point are valid (not `AST__BAD` or `nan`), false otherwise
+    */
+    void applyForward(ConstArray2D const &from, Array2D const &to,
+                      ndarray::Array<bool, 1, 1> const &isValid) const {
+        _tran(from, true, to, isValid);
+    }
+
+    /**
+    Perform a forward transformation on a 2-D array, returning the results as a new array
+    and reporting which points could be transformed
+
+    @param[in] from  input coordinates, with dimensions (nPts, nIn)
+    @param[out] isValid  pre-allocated array of nPts flags, each set true if all output coordinates
+        for that point are valid (not `nan`), false otherwise
+    @return the results as a new array with dimensions (nPts, nOut)
+    */
+    Array2D applyForward(ConstArray2D const &from, ndarray::Array<bool, 1, 1> const &isValid) const {
+        Array2D to = ndarray::allocate(getNOut(), from.getSize<1>());
+        _tran(from, true, to, isValid);
         return to;
     }
 
@@ -281,27 +350,81 @@ public:
         auto fromArr = arrayFromVector(from, getNIn());
         std::vector<double> to(fromArr.getSize<1>() * getNOut());
         auto toArr = arrayFromVector(to, getNOut());
-        _tran(fromArr, true, toArr);
+        _tran(fromArr, true, toArr, true);
         return to;
     }
 
+    /**
+    Perform a forward transformation on a 2-D array with arbitrary strides,
+    putting the results into a pre-allocated 2-D array with arbitrary strides
+
+    This allows transforming points that are not stored with the values for each axis contiguous,
+    without first copying them. For example for points stored as interleaved (x, y) pairs,
+    pass a view whose stride is 2 between points and 1 between axes.
+    Such data is copied to and from a small buffer, one tile of points at a time.
+
+    @param[in] from  input coordinates, with dimensions (nPts, nIn) as for the other overloads
+    @param[out] to  transformed coordinates, with dimensions (nPts, nOut) as for the other overloads
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
+    */
+    void applyForwardStrided(ConstStridedArray2D const &from, StridedArray2D const &to,
+                             bool badToNan = true) const {
+        _tran(from, true, to, badToNan);
+    }
+
     /**
     Perform an inverse transformation on a 2-D array, putting the results into a pre-allocated 2-D array
 
     @param[in] from  input coordinates, with dimensions (nPts, nOut)
     @param[out] to  transformed coordinates, with dimensions (nPts, nIn)
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
     */
-    void applyInverse(ConstArray2D const &from, Array2D const &to) const { _tran(from, false, to); }
+    void applyInverse(ConstArray2D const &from, Array2D const &to, bool badToNan = true) const {
+        _tran(from, false, to, badToNan);
+    }
 
     /**
     Perform an inverse transformation on a 2-D array, returning the results as a new 2-D array
 
     @param[in] from  output coordinates, with dimensions (nPts, nOut)
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
+    @return the results as a new array with dimensions (nPts, nIn)
+    */
+    Array2D applyInverse(ConstArray2D const &from, bool badToNan = true) const {
+        Array2D to = ndarray::allocate(getNIn(), from.getSize<1>());
+        _tran(from, false, to, badToNan);
+        return to;
+    }
+
+    /**
+    Perform an inverse transformation on a 2-D array, putting the results into a pre-allocated 2-D array
+    and reporting which points could be transformed
+
+    @param[in] from  input coordinates, with dimensions (nPts, nOut)
+    @param[out] to  transformed coordinates, with dimensions (nPts, nIn)
+    @param[out] isValid  pre-allocated array of nPts flags, each set true if all output coordinates
+        for that point are valid (not `AST__BAD` or `nan`), false otherwise
+    */
+    void applyInverse(ConstArray2D const &from, Array2D const &to,
+                      ndarray::Array<bool, 1, 1> const &isValid) const {
+        _tran(from, false, to, isValid);
+    }
+
+    /**
+    Perform an inverse transformation on a 2-D array, returning the results as a new array
+    and reporting which points could be transformed
+
+    @param[in] from  output coordinates, with dimensions (nPts, nOut)
+    @param[out] isValid  pre-allocated array of nPts flags, each set true if all output coordinates
+        for that point are valid (not `nan`), false otherwise
     @return the results as a new array with dimensions (nPts, nIn)
     */
-    Array2D applyInverse(ConstArray2D const &from) const {
+    Array2D applyInverse(ConstArray2D const &from, ndarray::Array<bool, 1, 1> const &isValid) const {
         Array2D to = ndarray::allocate(getNIn(), from.getSize<1>());
-        _tran(from, false, to);
+        _tran(from, false, to, isValid);
         return to;
     }
 
@@ -315,10 +438,26 @@ public:
         auto fromArr = arrayFromVector(from, getNOut());
         std::vector<double> to(fromArr.getSize<1>() * getNIn());
         auto toArr = arrayFromVector(to, getNIn());
-        _tran(fromArr, false, toArr);
+        _tran(fromArr, false, toArr, true);
         return to;
     }
 
+    /**
+    Perform an inverse transformation on a 2-D array with arbitrary strides,
+    putting the results into a pre-allocated 2-D array with arbitrary strides
+
+    See applyForwardStrided for details.
+
+    @param[in] from  input coordinates, with dimensions (nPts, nOut) as for the other overloads
+    @param[out] to  transformed coordinates, with dimensions (nPts, nIn) as for the other overloads
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in the output;
+        if false then leave `AST__BAD` unchanged, which saves a little time
+    */
+    void applyInverseStrided(ConstStridedArray2D const &from, StridedArray2D const &to,
+                             bool badToNan = true) const {
+        _tran(from, false, to, badToNan);
+    }
+
     /**
     Transform a grid of points in the forward direction
 
@@ -411,6 +550,46 @@ protected:
         return std::static_pointer_cast<Mapping>(copyImpl<Mapping, AstMapping>());
     }
 
+    /**
+    Transform points without using AST, if this class supports that for the requested direction
+
+    Subclasses that can transform points more efficiently than AST may override this;
+    the default implementation returns false. The arguments match those of astTranN:
+    the value of axis `i` of point `j` is at `from[i * fromStride + j]`, and likewise for `to`.
+    Output values that cannot be computed must be set to `AST__BAD`, as AST does.
+
+    @param[in] nPts  Number of points to transform
+    @param[in] nFromAxes  Number of input axes
+    @param[in] fromStride  Stride between axes of `from`
+    @param[in] from  Input coordinates; `nan` has been replaced with `AST__BAD`
+    @param[in] doForward  If true then perform a forward transform, else inverse
+    @param[in] nToAxes  Number of output axes
+    @param[in] toStride  Stride between axes of `to`
+    @param[out] to  Transformed coordinates
+    @return true if the points were transformed, false if AST must be used instead
+    */
+    virtual bool tranNative(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward,
+                            int nToAxes, int toStride, double *to) const {
+        return false;
+    }
+
+    /**
+    Is the fixed cost of each call to transform points large compared to the cost per point?
+
+    If true, and the data is laid out so that no copying is needed, then points are transformed
+    with a single call rather than in tiles of TILE_NPOINTS points (see _tranRange).
+    The default implementation returns false, because for most mappings the per-call cost is small,
+    and transforming in tiles lets the output be converted from `AST__BAD` to `nan` while it is in the cache.
+    */
+    virtual bool hasCostlyTranCall() const { return false; }
+
+    virtual void clearCache() override {
+        _nIn = -1;
+        _nOut = -1;
+        _isInverted = -1;
+        Object::clearCache();
+    }
+
     /**
     Return a deep copy of one of the two component mappings.
 
@@ -428,20 +607,80 @@ protected:
     std::shared_ptr<Class> decompose(int i, bool copy) const;
 
 private:
+    /// Number of points transformed by each call to _tranTile in _tranRange, if the data must be copied
+    static int constexpr TILE_NPOINTS = 4096;
+
     /**
     Implement applyForward and applyInverse, putting the results into a pre-allocated 2-D array.
 
     @param[in] from  input coordinates, with dimensions (nPts, nIn)
     @param[in] doForward  if true then perform a forward transform, else inverse
     @param[out] to  transformed coordinates, must be pre-allocated with dimensions (nPts, nOut)
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in `to`
+    */
+    void _tran(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to,
+               bool badToNan) const;
+
+    /**
+    Implement the overloads of applyForward and applyInverse that report which points are valid.
+
+    @param[in] from  input coordinates, with dimensions (nPts, nIn)
+    @param[in] doForward  if true then perform a forward transform, else inverse
+    @param[out] to  transformed coordinates, must be pre-allocated with dimensions (nPts, nOut)
+    @param[out] isValid  flags indicating which points are valid, must be pre-allocated with nPts elements
+    */
+    void _tran(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to,
+               ndarray::Array<bool, 1, 1> const &isValid) const;
+
+    /**
+    Transform the points in columns [begin, end) of `from`, putting the results in the same columns of `to`.
+
+    Unlike _tran this does not check the dimensions of `from` and `to` (the caller must do that),
+    and it only touches the specified columns, so a large array can be transformed in independent pieces.
+
+    Points are transformed in tiles of TILE_NPOINTS points, so the data can be copied
+    through small buffers: each tile of input is checked for `nan` and, only if one is found,
+    copied to a buffer with `nan` replaced by `AST__BAD`. AST requires the values for each axis
+    to be contiguous, so if they are not then every tile of input is copied to a buffer,
+    and every tile of output is computed in a buffer and then copied.
+    `AST__BAD` is replaced with `nan` in each tile of output while it is still in the cache,
+    rather than in a separate pass over the whole output array.
+
+    However, if @ref hasCostlyTranCall is true (e.g. for a @ref FrameSet, for which each call
+    finds and simplifies the mapping), the values for each axis of `from` and `to` are contiguous
+    and `from` contains no `nan`, then all points are transformed with a single call.
+
+    @param[in] from  input coordinates, with dimensions (nAxes, nPts)
+    @param[in] doForward  if true then perform a forward transform, else inverse
+    @param[out] to  transformed coordinates, with dimensions (nAxes, nPts)
+    @param[in] begin  index of first point to transform
+    @param[in] end  index of one past the last point to transform
+    @param[in] badToNan  if true then replace `AST__BAD` with `nan` in `to`
+    @param[out] isValid  if not null: pointer to the flag for point 0 (not point `begin`);
+        the flags for points [begin, end) are set true if all output coordinates are valid, else false
     */
-    void _tran(ConstArray2D const &from, bool doForward, Array2D const &to) const;
+    void _tranRange(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to, int begin,
+                    int end, bool badToNan, bool *isValid = nullptr) const;
+
+    /**
+    Transform one tile of points using tranNative, if supported, else astTranN.
+
+    See tranNative for the arguments.
+    */
+    void _tranTile(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward, int nToAxes,
+                   int toStride, double *to) const;
 
     /**
     Implementat tranGridForward and tranGridInverse, which see.
     */
     void _tranGrid(PointI const &lbnd, PointI const &ubnd, double tol, int maxpix, bool doForward,
                    Array2D const &to) const;
+
+    // Cached values of NIn, NOut and Invert (as 0 or 1); -1 if not yet known.
+    // See clearCache for how the cache is kept up to date.
+    mutable int _nIn = -1;
+    mutable int _nOut = -1;
+    mutable int _isInverted = -1;
 };
 
 }  // namespace ast
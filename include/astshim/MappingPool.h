@@ -0,0 +1,141 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef ASTSHIM_MAPPINGPOOL_H
+#define ASTSHIM_MAPPINGPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ndarray.h"
+
+#include "astshim/base.h"
+#include "astshim/Mapping.h"
+
+namespace ast {
+
+/**
+A pool of deep copies of a @ref Mapping, used to transform large arrays of points using several threads.
+
+AST objects may only be used by the thread that has locked them (see @ref Object.lock),
+so a single @ref Mapping cannot be shared between threads. A MappingPool holds one deep copy
+of the mapping per thread. Each call to @ref applyForward or @ref applyInverse splits the points
+into contiguous ranges of columns, one per thread, and each thread locks its own copy,
+transforms its range of points in place in the output array, then unlocks the copy again.
+The copies are kept and reused for every call, so the cost of copying the mapping is only paid once.
+
+The copies are made when the pool is constructed, so later changes to the original mapping
+do not affect the pool.
+
+@note MappingPool is a convenience class with no corresponding class in AST.
+*/
+class MappingPool {
+    friend class detail::TestAccess;
+
+public:
+    /// Minimum number of points to transform in each thread; smaller arrays use fewer threads.
+    static int constexpr MIN_POINTS_PER_THREAD = 1000;
+
+    /**
+    Construct a MappingPool
+
+    @param[in] mapping  Mapping to copy
+    @param[in] nThreads  Number of threads (and deep copies of `mapping`) to use;
+        if 0 then use the number of concurrent threads supported by the hardware.
+
+    @throws std::invalid_argument if `nThreads` < 0
+    */
+    explicit MappingPool(Mapping const &mapping, int nThreads = 0);
+
+    ~MappingPool();
+
+    MappingPool(MappingPool const &) = delete;
+    MappingPool(MappingPool &&) = delete;
+    MappingPool &operator=(MappingPool const &) = delete;
+    MappingPool &operator=(MappingPool &&) = delete;
+
+    /// Get the number of input axes of the mapping
+    int getNIn() const { return _nIn; }
+
+    /// Get the number of output axes of the mapping
+    int getNOut() const { return _nOut; }
+
+    /// Get the maximum number of threads used to transform points
+    int getNThreads() const { return static_cast<int>(_copies.size()); }
+
+    /**
+    Perform a forward transformation on 2-D array, putting the results into a pre-allocated 2-D array
+
+    @param[in] from  input coordinates, with dimensions (nIn, nPts)
+    @param[out] to  transformed coordinates, with dimensions (nOut, nPts)
+    */
+    void applyForward(ConstArray2D const &from, Array2D const &to) const { _tran(from, true, to); }
+
+    /**
+    Perform a forward transformation on a 2-D array, returning the results as a new array
+
+    @param[in] from  input coordinates, with dimensions (nIn, nPts)
+    @return the results as a new array with dimensions (nOut, nPts)
+    */
+    Array2D applyForward(ConstArray2D const &from) const {
+        Array2D to = ndarray::allocate(getNOut(), from.getSize<1>());
+        _tran(from, true, to);
+        return to;
+    }
+
+    /**
+    Perform an inverse transformation on a 2-D array, putting the results into a pre-allocated 2-D array
+
+    @param[in] from  input coordinates, with dimensions (nOut, nPts)
+    @param[out] to  transformed coordinates, with dimensions (nIn, nPts)
+    */
+    void applyInverse(ConstArray2D const &from, Array2D const &to) const { _tran(from, false, to); }
+
+    /**
+    Perform an inverse transformation on a 2-D array, returning the results as a new 2-D array
+
+    @param[in] from  output coordinates, with dimensions (nOut, nPts)
+    @return the results as a new array with dimensions (nIn, nPts)
+    */
+    Array2D applyInverse(ConstArray2D const &from) const {
+        Array2D to = ndarray::allocate(getNIn(), from.getSize<1>());
+        _tran(from, false, to);
+        return to;
+    }
+
+private:
+    /*
+    Implement applyForward and applyInverse, putting the results into a pre-allocated 2-D array.
+    */
+    void _tran(ConstArray2D const &from, bool doForward, Array2D const &to) const;
+
+    int _nIn;
+    int _nOut;
+    // Deep copies of the mapping, one per thread; each is unlocked unless in use by a thread
+    std::vector<std::shared_ptr<Mapping>> _copies;
+    // Serializes calls to _tran, since each copy may only be used by one thread at a time
+    mutable std::mutex _mutex;
+};
+
+}  // namespace ast
+
+#endif
@@ -22,8 +22,12 @@
 #ifndef ASTSHIM_OBJECT_H
 #define ASTSHIM_OBJECT_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <memory>
+#include <utility>
 
 #include "astshim/base.h"
 #include "astshim/detail/utils.h"
@@ -60,8 +64,18 @@ public:
 
     virtual ~Object() {}
 
-    /// Copy constructor: make a deep copy
-    Object(Object const &object) : _objPtr(object.getRawPtrCopy(), &detail::annulAstObject) {}
+    /**
+    Copy constructor: make a deep copy
+
+    If copy-on-write is enabled (see @ref setCopyOnWrite) the AST object is shared instead,
+    and is deep copied when this object or the original is first modified.
+
+    The cached @ref hash is not copied, because the copy need not have the same content:
+    AST does not copy the ID attribute.
+    */
+    Object(Object const &object) : _objPtr(nullptr, &detail::annulAstObject) {
+        _objPtr.reset(object._shareOrCopyRawPtr(_copyOnWrite));
+    }
     Object(Object &&) = default;
     Object &operator=(Object const &) = delete;
     Object &operator=(Object &&) = default;
@@ -71,6 +85,15 @@ public:
 
     For two objects be equal, they both must have the same attributes and all contained objects
     must be equal.
+
+    The objects are compared as they are written by AST (as for `show(false)`): this object
+    is written in full and its text recorded, then `rhs` is written and each line is compared
+    against the recorded text as AST produces it. At the first line that differs, writing `rhs`
+    is stopped by setting the AST error status, which is then cleared. Thus comparing equal objects
+    costs two full writes, in which AST formats every value as text, and comparing unequal objects
+    costs one full write and a partial write.
+    Objects that are the same AST object or are of different classes are compared without writing them.
+    Cached hashes (see @ref hash) are not used, since they may be out of date (see @ref clearCache).
     */
     bool operator==(Object const &rhs) const;
 
@@ -82,6 +105,59 @@ public:
     bool operator!=(Object const &rhs) const {
         return !(*this == rhs); };
 
+    /**
+    Return a hash of the contents of this object, such that objects that are equal
+    (see operator==) have equal hashes
+
+    The hash is the 64-bit FNV-1a hash of the text written by AST (as for `show(false)`),
+    so it is the same in every process and on every platform, and may be used as a key
+    for caches that persist between processes.
+    It is computed when first needed and remembered until the object is modified (see @ref clearCache).
+
+    Objects are mutable, so in Python this is available as `hash()`, not `__hash__`, and objects cannot
+    be put in sets or used as dict keys directly; use the value of `hash()` as the key instead.
+
+    The hash depends on the structure of the object, not just its behavior:
+    for instance a @ref SeriesMap of two @ref ZoomMap "ZoomMaps" and the equivalent single @ref ZoomMap
+    have different hashes. To key a cache on what a @ref Mapping does, hash @ref Mapping.simplified
+    "simplified()".
+    */
+    std::uint64_t hash() const {
+        if (!_hasHash) {
+            _hash = _computeHash();
+            _hasHash = true;
+        }
+        return _hash;
+    }
+
+    /**
+    Enable or disable copy-on-write for all copies made from now on
+
+    When copy-on-write is enabled, the copy constructor and `copy` share the AST object
+    (using astClone) instead of making a deep copy (using astCopy). An object whose AST object
+    is shared this way makes a deep copy of it the first time the object is modified,
+    e.g. by a setter or @ref Mapping.permAxes "permAxes", and so copies still behave as
+    independent objects. This saves time and memory when copies are mostly read,
+    especially copies of large objects such as a @ref PolyMap with many coefficients.
+
+    Copy-on-write is disabled by default. Enable it once, at startup. Objects made while it was enabled
+    continue to work correctly if it is later disabled.
+
+    Until one of them is modified, an object and its copy are the @ref same AST object
+    and @ref getRefCount counts both. Objects with an ID (see @ref setID) are always deep copied,
+    since the ID is not copied.
+
+    @note A @ref CmpMap (and other compound objects) made from an object that shares its AST object
+    through copy-on-write does not see later changes to that object. Provide a deep copy
+    made with copy-on-write disabled if that is needed.
+    */
+    static void setCopyOnWrite(bool enable);
+
+    /**
+    Is copy-on-write enabled? See @ref setCopyOnWrite.
+    */
+    static bool getCopyOnWrite();
+
     /**
     Construct an @ref Object from a string, using astFromString
     */
@@ -105,9 +181,24 @@ public:
     template <typename Class>
     static std::shared_ptr<Class> fromAstObject(AstObject *rawObj, bool copy);
 
-    /// Return a deep copy of this object.
+    /// Return a deep copy of this object (a copy-on-write copy if enabled; see @ref setCopyOnWrite).
     std::shared_ptr<Object> copy() const { return std::static_pointer_cast<Object>(copyPolymorphic()); }
 
+    /**
+    Return a copy of this object that shares the AST object until either of them is modified
+
+    Unlike @ref copy this shares the AST object whether or not copy-on-write is enabled
+    (see @ref setCopyOnWrite), so it is a cheap way to hand out a mutable copy of an object
+    that must not itself be changed, such as the views returned by
+    @ref FrameSet.getMappingView "FrameSet::getMappingView" and
+    @ref FrameSet.getFrameView "FrameSet::getFrameView".
+    Returns a deep copy if the object must never be shared or has an ID (which astCopy does not copy).
+
+    The copy is an instance of the class matching the AST class of this object,
+    e.g. a FrameDict is copied as a FrameSet.
+    */
+    std::shared_ptr<Object> lazyCopy() const;
+
     /**
     Clear the values of a specified set of attributes for an Object.
 
@@ -200,7 +291,13 @@ public:
     option was not specified when running the "configure" script).
     */
     void lock(bool wait) {
-        astLock(getRawPtr(), static_cast<int>(wait));
+        // Lock state is not content, so do not use the non-const getRawPtr, which clears all caches.
+        // An AST object shared through copy-on-write must still be made unique, else the lock
+        // would apply to every object sharing it; this happens at most once per copy.
+        if (_copyOnWrite) {
+            _makeUnique();
+        }
+        astLock(_objPtr.get(), static_cast<int>(wait));
         assertOK();
     }
 
@@ -278,7 +375,11 @@ public:
     option was not specified when running the "configure" script).
     */
     void unlock(bool report = false) {
-        astUnlock(getRawPtr(), static_cast<int>(report));
+        // See lock for why this does not use the non-const getRawPtr
+        if (_copyOnWrite) {
+            _makeUnique();
+        }
+        astUnlock(_objPtr.get(), static_cast<int>(report));
         assertOK();
     }
 
@@ -287,11 +388,20 @@ public:
 
     Intended for internal use only, but cannot be made protected
     without endless "friend class" declarations.
+
+    The non-const version calls @ref clearCache, since the AST object may be modified
+    through the returned pointer.
     @{
     */
     AstObject const *getRawPtr() const { return &*_objPtr; };
 
-    AstObject *getRawPtr() { return &*_objPtr; };
+    AstObject *getRawPtr() {
+        if (_copyOnWrite) {
+            _makeUnique();
+        }
+        clearCache();
+        return &*_objPtr;
+    };
     ///@}
 
 protected:
@@ -303,11 +413,14 @@ protected:
     /**
     Functor to make an astshim instance from a raw AST pointer of the corresponding type.
 
+    The result is returned as a shared pointer to Object, so that pointers to all instantiations
+    have the same type.
+
     @tparam ShimT  Output astshim class
     @tparam AstT  Output AST class
     */
     template <typename ShimT, typename AstT>
-    static std::shared_ptr<ShimT> makeShim(AstObject *p) {
+    static std::shared_ptr<Object> makeShim(AstObject *p) {
         return std::shared_ptr<ShimT>(new ShimT(reinterpret_cast<AstT *>(p)));
     }
 
@@ -318,8 +431,10 @@ protected:
     */
     template <typename T, typename AstT>
     std::shared_ptr<T> copyImpl() const {
-        auto *rawptr = reinterpret_cast<AstT *>(astCopy(getRawPtr()));
+        bool shared = false;
+        auto *rawptr = reinterpret_cast<AstT *>(_shareOrCopyRawPtr(shared));
         auto retptr = std::shared_ptr<T>(new T(rawptr));
+        static_cast<Object &>(*retptr)._copyOnWrite = shared;
         assertOK();
         return retptr;
     }
@@ -338,6 +453,37 @@ protected:
     */
     virtual std::shared_ptr<Object> copyPolymorphic() const = 0;
 
+    /**
+    Discard any information cached about the AST object.
+
+    This is called whenever the AST object may have been modified, i.e. by the non-const version
+    of @ref getRawPtr (which all methods that modify the AST object use) and when the AST object
+    is swapped for another. Subclasses that cache attributes must override this to clear their cache,
+    and call the base class version. Object itself caches the value of @ref hash.
+
+    @warning Changes made to the AST object through a different shim object that shares it
+    (e.g. a shallow copy) are not detected.
+    */
+    virtual void clearCache() { _hasHash = false; }
+
+    /**
+    Make sure the AST object is not, and will not be, shared through copy-on-write
+    (see @ref setCopyOnWrite)
+
+    Const methods that return a shallow copy of part of the AST object, such as
+    @ref FrameSet.getFrame "FrameSet::getFrame", @ref Mapping.decompose "Mapping::decompose"
+    (and so the `operator[]` of compound mappings and frames) and @ref FrameSet.getMappingView
+    "FrameSet::getMappingView", must call this first, since changes made
+    through the shallow copy are changes to this object that the non-const version of
+    @ref getRawPtr never sees.
+    */
+    void preventSharing() const {
+        if (_copyOnWrite) {
+            _makeUnique();
+        }
+        _neverShare = true;
+    }
+
     /**
     Get the value of an attribute as a bool
 
@@ -524,6 +670,11 @@ private:
     */
     static std::shared_ptr<Object> _basicFromAstObject(AstObject *rawObj);
 
+    /*
+    Compute the value returned by hash, without using the cached value
+    */
+    std::uint64_t _computeHash() const;
+
     /*
     Get a deep copy of the raw AST pointer.
     */
@@ -533,16 +684,58 @@ private:
         return rawPtrCopy;
     }
 
+    /*
+    Get the raw AST pointer for a copy of this object
+
+    If copy-on-write is enabled, return a clone of the raw AST pointer and mark this object
+    as sharing it; otherwise return a deep copy. The AST object is never shared if it is already
+    shared by other means (e.g. this is a shallow copy from FrameSet::getFrame)
+    or preventSharing has been called.
+
+    @param[out] shared  Set true if the returned pointer is a clone, false if a deep copy.
+    */
+    AstObject *_shareOrCopyRawPtr(bool &shared) const;
+
+    /*
+    Replace the AST object with a deep copy if it is shared, and clear _copyOnWrite
+    */
+    void _makeUnique() const;
+
     /*
     Swap the raw object pointers between this and another object
     */
     void swapRawPointers(Object &other) noexcept {
         swap(_objPtr, other._objPtr);
+        std::swap(_copyOnWrite, other._copyOnWrite);
+        std::swap(_neverShare, other._neverShare);
+        clearCache();
+        other.clearCache();
     }
 
-    ObjectPtr _objPtr;
+    // Mutable so that preventSharing may replace a shared AST object with a copy,
+    // which does not change the contents of this object.
+    mutable ObjectPtr _objPtr;
+    // Is the AST object possibly shared through copy-on-write? See setCopyOnWrite.
+    mutable bool _copyOnWrite = false;
+    // Must the AST object never be shared through copy-on-write? See preventSharing.
+    mutable bool _neverShare = false;
+    // Cached value of hash, valid if _hasHash is true; see clearCache for how the cache is kept up to date
+    mutable std::uint64_t _hash = 0;
+    mutable bool _hasHash = false;
 };
 
 }  // namespace ast
 
+namespace std {
+
+/// Hash an ast::Object by its contents, so equal objects may be used as keys of unordered containers
+template <>
+struct hash<ast::Object> {
+    std::size_t operator()(ast::Object const &object) const {
+        return static_cast<std::size_t>(object.hash());
+    }
+};
+
+}  // namespace std
+
 #endif
@@ -87,13 +87,20 @@ protected:
         return copyImpl<ParallelMap, AstCmpMap>();
     }
 
-    /// Construct a ParallelMap from a raw AST pointer
-    /// @todo add a test that the CmpMap is parallel
+    /**
+    Construct a ParallelMap from a raw AST pointer
+
+    @throws std::runtime_error if the CmpMap is in series
+    */
     explicit ParallelMap(AstCmpMap *rawptr) : CmpMap(rawptr) {
         if (getSeries()) {
             throw std::runtime_error("Compound mapping is in series");
         }
     }
+
+private:
+    /// Construct a ParallelMap from a raw AST pointer to a CmpMap that the caller has checked is in parallel
+    ParallelMap(AstCmpMap *rawptr, SeriesChecked) : CmpMap(rawptr, false) {}
 };
 
 }  // namespace ast
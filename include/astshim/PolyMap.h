@@ -28,6 +28,7 @@
 
 #include "astshim/base.h"
 #include "astshim/Mapping.h"
+#include "astshim/detail/polyEvaluator.h"
 
 namespace ast {
 
@@ -45,9 +46,14 @@ All those of @ref Mapping plus:
 - @ref PolyMap_IterInverse "IterInverse": provide an iterative inverse transformation?
 - @ref PolyMap_NIterInverse "NIterInverse": maximum number of iterations for iterative inverse.
 - @ref PolyMap_TolInverse "TolInverse": target relative error for iterative inverse.
+
+Transforms that are defined by coefficients are evaluated by astshim rather than AST
+(see detail::PolyEvaluator), which is considerably faster for large numbers of points.
+An iterative inverse is always evaluated by AST.
 */
 class PolyMap : public Mapping {
     friend class Object;
+    friend class detail::TestAccess;
 
 public:
     /**
@@ -240,6 +246,17 @@ protected:
     /// Construct a PolyMap from an raw AST pointer
     PolyMap(AstPolyMap *map);
 
+    /// Transform points using detail::PolyEvaluator, unless the transform is iterative
+    bool tranNative(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward, int nToAxes,
+                    int toStride, double *to) const override;
+
+    virtual void clearCache() override {
+        _evaluatorsReady = false;
+        _forwardEvaluator.reset();
+        _inverseEvaluator.reset();
+        Mapping::clearCache();
+    }
+
 private:
     /// Make a raw AstPolyMap with specified forward and inverse transforms.
     AstPolyMap *_makeRawPolyMap(ConstArray2D const &coeff_f, ConstArray2D const &coeff_i,
@@ -247,6 +264,16 @@ private:
 
     /// Make a raw AstPolyMap with a specified forward transform and an optional iterative inverse.
     AstPolyMap *_makeRawPolyMap(ConstArray2D const &coeff_f, int nout, std::string const &options = "") const;
+
+    /// Set _forwardEvaluator and _inverseEvaluator from the coefficients
+    void _makeEvaluators() const;
+
+    // Evaluators for the forward and inverse coefficients of the PolyMap as constructed
+    // (ignoring Invert); null if that transform is iterative or has no coefficients.
+    // They are made when first needed and reset by clearCache.
+    mutable bool _evaluatorsReady = false;
+    mutable std::shared_ptr<detail::PolyEvaluator const> _forwardEvaluator;
+    mutable std::shared_ptr<detail::PolyEvaluator const> _inverseEvaluator;
 };
 
 }  // namespace ast
@@ -87,12 +87,20 @@ protected:
         return copyImpl<SeriesMap, AstCmpMap>();
     }
 
-    /// Construct a SeriesMap from a raw AST pointer
+    /**
+    Construct a SeriesMap from a raw AST pointer
+
+    @throws std::runtime_error if the CmpMap is in parallel
+    */
     explicit SeriesMap(AstCmpMap *rawptr) : CmpMap(rawptr) {
         if (!getSeries()) {
             throw std::runtime_error("Compound mapping is in parallel");
         }
     }
+
+private:
+    /// Construct a SeriesMap from a raw AST pointer to a CmpMap that the caller has checked is in series
+    SeriesMap(AstCmpMap *rawptr, SeriesChecked) : CmpMap(rawptr, true) {}
 };
 
 }  // namespace ast
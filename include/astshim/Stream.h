@@ -35,11 +35,18 @@ namespace ast {
 
 class Channel;  // forward declaration for friendship
 
+namespace detail {
+class MappedFile;  // memory-mapped file used by MmapStream; defined in Stream.cc
+}  // namespace detail
+
 /**
 A stream for ast::Channel
 */
 class Stream {
 public:
+    /// Default size of the sink buffer, in bytes; see @ref setSinkBufferSize
+    static std::size_t constexpr DEFAULT_SINK_BUFFER_SIZE = 1 << 16;
+
     /**
     Construct a Stream from input and output std::streams
 
@@ -49,7 +56,13 @@ public:
                         may be nullptr if sinking not needed
     */
     explicit Stream(std::istream *istreamPtr, std::ostream *ostreamPtr)
-            : _istreamPtr(), _ostreamPtr(), _sourceStr(), _isFits(false) {
+            : _istreamPtr(),
+              _ostreamPtr(),
+              _mappedFilePtr(),
+              _sourceStr(),
+              _sinkBuffer(),
+              _sinkBufferSize(DEFAULT_SINK_BUFFER_SIZE),
+              _isFits(false) {
         if (istreamPtr) {
             _istreamPtr = std::make_shared<std::istream>(istreamPtr->rdbuf());
         }
@@ -82,6 +95,9 @@ public:
         call to this function.
     */
     char const *source() {
+        if (_mappedFilePtr) {
+            return _sourceMapped();
+        }
         if ((_istreamPtr) && (*_istreamPtr)) {
             if (_isFits) {
                 // http://codereview.stackexchange.com/a/28759
@@ -100,6 +116,10 @@ public:
     /**
     Sink (write) to the stream
 
+    If the sink buffer size is nonzero then the data is appended to the sink buffer,
+    which is written to the stream (without flushing it) whenever it reaches that size,
+    and by @ref flush. Otherwise the data is written and the stream is flushed.
+
     @param[in] cstr  data to write; a newline is then written if _isFits false
     @return true on success or if there is no stream pointer (a normal mode),
         false if the stream pointer is in a bad state after writing
@@ -109,9 +129,19 @@ public:
     */
     bool sink(char const *cstr) {
         if (_ostreamPtr) {
-            (*_ostreamPtr) << cstr;
-            if (!_isFits) {
-                (*_ostreamPtr) << std::endl;
+            if (_sinkBufferSize == 0) {
+                (*_ostreamPtr) << cstr;
+                if (!_isFits) {
+                    (*_ostreamPtr) << std::endl;
+                }
+            } else {
+                _sinkBuffer += cstr;
+                if (!_isFits) {
+                    _sinkBuffer += '\n';
+                }
+                if (_sinkBuffer.size() >= _sinkBufferSize) {
+                    _writeSinkBuffer();
+                }
             }
             return static_cast<bool>(*_ostreamPtr);
         } else {
@@ -119,6 +149,40 @@ public:
         }
     }
 
+    /**
+    Write any buffered sink data to the stream and flush the stream
+
+    @ref Channel calls this at the end of each write, and when it is destroyed.
+
+    @return true on success or if there is no stream pointer,
+        false if the stream pointer is in a bad state after writing
+    */
+    bool flush() {
+        if (_ostreamPtr) {
+            _writeSinkBuffer();
+            _ostreamPtr->flush();
+            return static_cast<bool>(*_ostreamPtr);
+        } else {
+            return true;
+        }
+    }
+
+    /// Get the size of the sink buffer, in bytes; 0 if sink data is not buffered
+    std::size_t getSinkBufferSize() const { return _sinkBufferSize; }
+
+    /**
+    Set the size of the sink buffer, in bytes
+
+    @param[in] size  Size of the sink buffer; 0 to write and flush each line as it is sunk,
+        which is slow, especially for files on network filesystems.
+
+    A @ref Channel uses a copy of its stream, so set this before constructing the channel.
+    */
+    void setSinkBufferSize(std::size_t size) {
+        flush();
+        _sinkBufferSize = size;
+    }
+
     friend class Channel;
 
     /// get isfits
@@ -128,12 +192,30 @@ protected:
     /// set isFits
     void setIsFits(bool isFits) { _isFits = isFits; }
 
+    /// Write the sink buffer to the output stream, without flushing it, and clear the buffer
+    void _writeSinkBuffer() const {
+        if (!_sinkBuffer.empty()) {
+            _ostreamPtr->write(_sinkBuffer.data(), _sinkBuffer.size());
+            _sinkBuffer.clear();
+        }
+    }
+
     std::shared_ptr<std::istream> _istreamPtr;  ///< input stream
     std::shared_ptr<std::ostream> _ostreamPtr;  ///< output stream
+    /// memory-mapped source file, if any; shared by copies, as are the std::stream pointers
+    std::shared_ptr<detail::MappedFile> _mappedFilePtr;
     /// string containing a local copy of sourced data,
     /// so @ref source can return a `char *` that won't disappear right away
     std::string _sourceStr;
-    bool _isFits;  ///< is this a FITS stream?
+    /// data sunk but not yet written to the output stream; mutable so const methods
+    /// that read the output stream, such as StringStream::getSinkData, can write it first
+    mutable std::string _sinkBuffer;
+    std::size_t _sinkBufferSize;  ///< size at which to write _sinkBuffer; 0 for no buffering
+    bool _isFits;                 ///< is this a FITS stream?
+
+private:
+    /// Implementation of @ref source for a memory-mapped file
+    char const *_sourceMapped();
 };
 
 /**
@@ -171,6 +253,35 @@ private:
     std::string _path;  ///< Path to file
 };
 
+/**
+Memory-mapped file source for channels
+
+The file is mapped read-only and each line is copied from the mapping into a single reusable buffer,
+which is returned to AST. Thus reading does no stream buffering or per-character extraction,
+and the mapped pages are never written to, so they stay shared with the page cache.
+
+The mapping is released when the last copy of the stream is destroyed.
+*/
+class MmapStream : public Stream {
+public:
+    /**
+    Construct a MmapStream for reading
+
+    @param[in] path  Path to file as a string
+
+    @throws std::runtime_error if the file cannot be opened or mapped
+    */
+    explicit MmapStream(std::string const &path);
+
+    virtual ~MmapStream() {}
+
+    /// Get the path to the file, as a string
+    std::string getPath() const { return _path; }
+
+private:
+    std::string _path;  ///< Path to file
+};
+
 /**
 String-based source and sink for channels
 
@@ -196,11 +307,15 @@ public:
     /// Get a copy of the text from the sink/output stream, without changing the stream
     std::string getSourceData() const { return _istringstreamPtr->str(); }
 
-    /// Get a copy of the text from the sink/output stream, without changing the stream
-    std::string getSinkData() const { return _ostringstreamPtr->str(); }
+    /// Get a copy of the text from the sink/output stream, including any buffered sink data
+    std::string getSinkData() const {
+        _writeSinkBuffer();
+        return _ostringstreamPtr->str();
+    }
 
-    /// Move output/sink data to input/source
+    /// Move output/sink data, including any buffered sink data, to input/source
     void sinkToSource() {
+        flush();
         _istringstreamPtr->clear();
         _istringstreamPtr->str(getSinkData());
         _ostringstreamPtr->str("");
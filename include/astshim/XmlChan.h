@@ -49,7 +49,7 @@ public:
     Construct a channel that uses a provided Stream
 
     @param[in] stream  Stream for channel I/O:
-        - For file I/O: provide a FileStream
+        - For file I/O: provide a FileStream, or to read a large file quickly, a MmapStream
         - For string I/O (e.g. unit tests): provide a StringStream
         - For standard I/O provide `Stream(&std::cin, &std::cout))`
             where either stream can be nullptr if not wanted
@@ -45,6 +45,23 @@ using Array2D = ndarray::Array<double, 2, 2>;
 */
 using ConstArray2D = ndarray::Array<const double, 2, 2>;
 /**
+1D array of double; typically used for one value per point
+*/
+using Array1D = ndarray::Array<double, 1, 1>;
+/**
+1D array of const double; typically used for one value per point
+*/
+using ConstArray1D = ndarray::Array<const double, 1, 1>;
+/**
+2D array of double with arbitrary strides; used for lists of points that are not stored
+with the values for each axis contiguous, such as interleaved (x, y) pairs
+*/
+using StridedArray2D = ndarray::Array<double, 2, 0>;
+/**
+2D array of const double with arbitrary strides; see StridedArray2D
+*/
+using ConstStridedArray2D = ndarray::Array<const double, 2, 0>;
+/**
 Vector of ints; typically used for the bounds of Mapping.tranGridForward and inverse
 */
 using PointI = std::vector<int>;
@@ -56,6 +73,11 @@ as an alternative to Array2D and ConstArray2D
 */
 using PointD = std::vector<double>;
 
+namespace detail {
+/// Test-only access to private members of some classes; see astshim/detail/testUtils.h
+class TestAccess;
+}  // namespace detail
+
 /**
 Data types held by a KeyMap
 */
@@ -103,7 +125,8 @@ Throw std::runtime_error if AST's state is bad
 @param  rawPtr2  An AST object to free if status is bad
 
 @note on the first call an error handler is registered
-that saves error messages to a buffer.
+that saves error messages to a buffer. The buffer is thread-local,
+so errors that occur simultaneously in different threads are reported separately.
 */
 void assertOK(AstObject *rawPtr1 = nullptr, AstObject *rawPtr2 = nullptr);
 
@@ -23,14 +23,22 @@
 #define ASTSHIM_DETAIL_TESTUTILS_H
 
 #include <cctype>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
 #include "astshim/base.h"
+#include "astshim/ChebyMap.h"
 #include "astshim/FrameDict.h"
 #include "astshim/FrameSet.h"
+#include "astshim/Mapping.h"
+#include "astshim/MappingPool.h"
+#include "astshim/PolyMap.h"
+#include "astshim/detail/polyEvaluator.h"
+#include "astshim/detail/utils.h"
 
 namespace ast {
 namespace detail {
@@ -45,6 +53,81 @@ FrameDict makeFrameDict(FrameSet const & frameSet) {
     return FrameDict(frameSet);
 }
 
+/**
+Transform points using AST's astTranN, bypassing any evaluation by astshim (see Mapping::tranNative)
+
+This exists to test that astshim's own evaluation of a Mapping matches AST.
+
+@param[in] mapping  Mapping to apply
+@param[in] from  Input points, with dimensions (nFromAxes, nPoints)
+@param[in] doForward  Apply the forward transform?
+@return Output points, with `AST__BAD` replaced by nan
+*/
+inline Array2D applyWithAst(Mapping const &mapping, ConstArray2D const &from, bool doForward) {
+    int const nFromAxes = doForward ? mapping.getNIn() : mapping.getNOut();
+    int const nToAxes = doForward ? mapping.getNOut() : mapping.getNIn();
+    assertEqual(from.getSize<0>(), "from.size[0]", static_cast<std::size_t>(nFromAxes), "from coords");
+    int const nPts = from.getSize<1>();
+    Array2D to = ndarray::allocate(nToAxes, nPts);
+    astTranN(mapping.getRawPtr(), nPts, nFromAxes, from.getStride<0>(), from.getData(),
+             static_cast<int>(doForward), nToAxes, to.getStride<0>(), to.getData());
+    assertOK();
+    astBadToNan(to);
+    return to;
+}
+
+/**
+Test-only access to private members of astshim classes
+
+This exists to test caches that have no effect other than on speed,
+without adding instrumentation to the code that uses them.
+*/
+class TestAccess {
+public:
+    /**
+    Get identifiers for the native evaluators (see PolyEvaluator) of a PolyMap or ChebyMap
+
+    The evaluators are not built by this call.
+
+    @param[in] mapping  PolyMap or ChebyMap
+    @return identifiers of the forward and inverse evaluators, which stay the same while an evaluator
+        is reused; 0 for an evaluator that has not been built or is not available.
+    @throws std::invalid_argument if `mapping` is not a PolyMap or ChebyMap
+    */
+    static std::vector<std::uintptr_t> getPolyEvaluatorIds(Mapping const &mapping) {
+        if (auto polyMap = dynamic_cast<PolyMap const *>(&mapping)) {
+            return _getIds(polyMap->_forwardEvaluator, polyMap->_inverseEvaluator);
+        }
+        if (auto chebyMap = dynamic_cast<ChebyMap const *>(&mapping)) {
+            return _getIds(chebyMap->_forwardEvaluator, chebyMap->_inverseEvaluator);
+        }
+        throw std::invalid_argument("this is a " + mapping.getClassName() +
+                                    ", which is not a PolyMap or ChebyMap");
+    }
+
+    /**
+    Get identifiers for the native evaluators of each copy of the mapping in a MappingPool
+
+    @return the identifiers returned by getPolyEvaluatorIds(Mapping const &) for each copy, concatenated
+    @throws std::invalid_argument if the mapping is not a PolyMap or ChebyMap
+    */
+    static std::vector<std::uintptr_t> getPolyEvaluatorIds(MappingPool const &pool) {
+        std::vector<std::uintptr_t> result;
+        for (auto const &copy : pool._copies) {
+            auto const ids = getPolyEvaluatorIds(*copy);
+            result.insert(result.end(), ids.begin(), ids.end());
+        }
+        return result;
+    }
+
+private:
+    static std::vector<std::uintptr_t> _getIds(std::shared_ptr<PolyEvaluator const> const &forward,
+                                               std::shared_ptr<PolyEvaluator const> const &inverse) {
+        return {reinterpret_cast<std::uintptr_t>(forward.get()),
+                reinterpret_cast<std::uintptr_t>(inverse.get())};
+    }
+};
+
 }  // namespace detail
 }  // namespace ast
 
@@ -22,7 +22,10 @@
 #ifndef ASTSHIM_DETAIL_UTILS_H
 #define ASTSHIM_DETAIL_UTILS_H
 
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <cctype>
 #include <limits>
 #include <sstream>
@@ -54,16 +57,73 @@ inline void assertEqual(T1 val1, std::string const &descr1, T2 val2, std::string
 }
 
 /**
-Replace `AST__BAD` with a quiet NaN in a vector
+Replace `AST__BAD` with a quiet NaN in a contiguous range of doubles
+
+@param[in, out] begin  pointer to the first value
+@param[in, out] end  pointer to one past the last value
+
+@note The loop body is branchless (every element is written) so that the compiler can vectorize it.
 */
-inline void astBadToNan(std::vector<double> &p) {
-    for (auto &val : p) {
-        if (val == AST__BAD) {
-            val = std::numeric_limits<double>::quiet_NaN();
-        }
+inline void astBadToNan(double *begin, double *end) {
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+    for (double *ptr = begin; ptr != end; ++ptr) {
+        *ptr = (*ptr == AST__BAD) ? nan : *ptr;
     }
 }
 
+/**
+Return true if any value in a contiguous range of doubles is NaN or infinite
+
+This is intended as a fast test of whether NaN values must be replaced with `AST__BAD`
+before passing data to AST. The test is done on the bits of each value and the results
+are combined with a bitwise or, which (unlike a floating-point sum) does not depend on the order
+of evaluation, and there is no early exit, so the compiler can vectorize the loop.
+*/
+inline bool hasNanOrInf(double const *begin, double const *end) {
+    std::uint64_t const absMask = 0x7fffffffffffffffULL;
+    std::uint64_t const exponentLsb = 0x0010000000000000ULL;
+    std::uint64_t result = 0;
+    for (double const *ptr = begin; ptr != end; ++ptr) {
+        std::uint64_t bits;
+        std::memcpy(&bits, ptr, sizeof(bits));
+        // NaN and infinity have all exponent bits set, so adding 1 to the exponent
+        // of the absolute value carries into the sign bit only for them
+        result |= (bits & absMask) + exponentLsb;
+    }
+    return (result >> 63) != 0;
+}
+
+/**
+Copy a contiguous range of doubles, replacing NaN with `AST__BAD`
+
+@param[in] begin  pointer to the first value to copy
+@param[in] end  pointer to one past the last value to copy
+@param[out] out  pointer to the first element of the output; there must be room for `end - begin` values
+*/
+inline void nanToAstBad(double const *begin, double const *end, double *out) {
+    for (double const *ptr = begin; ptr != end; ++ptr, ++out) {
+        *out = std::isnan(*ptr) ? AST__BAD : *ptr;
+    }
+}
+
+/**
+Set `isValid[i]` false for every value `begin[i]` that is `AST__BAD` or NaN
+
+@param[in] begin  pointer to the first value to test
+@param[in] end  pointer to one past the last value to test
+@param[in, out] isValid  pointer to the first element of the flags to update
+*/
+inline void updateIsValid(double const *begin, double const *end, bool *isValid) {
+    for (double const *ptr = begin; ptr != end; ++ptr, ++isValid) {
+        *isValid = *isValid && (*ptr != AST__BAD) && !std::isnan(*ptr);
+    }
+}
+
+/**
+Replace `AST__BAD` with a quiet NaN in a vector
+*/
+inline void astBadToNan(std::vector<double> &p) { astBadToNan(p.data(), p.data() + p.size()); }
+
 /**
 Replace `AST__BAD` with a quiet NaN in a 2-D array
 */
@@ -37,10 +37,13 @@ from .fitsTableContinued import *
 # misc
 from .mapBox import *
 from .mapSplit import *
+from .mappingPool import *
+from .compiledMapping import *
 from .quadApprox import *
 from .functional import *
 # channels
 from .fitsChanContinued import *
+from .fitsWcsWriter import *
 from .xmlChan import *
 # mappings
 from .chebyMap import *
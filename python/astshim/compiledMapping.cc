@@ -0,0 +1,63 @@
+/*
+ * LSST Data Management System
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ * See the COPYRIGHT file
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <pybind11/pybind11.h>
+#include "ndarray/pybind11.h"
+
+#include "astshim/base.h"
+#include "astshim/CompiledMapping.h"
+#include "astshim/Mapping.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace ast {
+namespace {
+
+PYBIND11_MODULE(compiledMapping, mod) {
+    py::module::import("astshim.mapping");
+
+    py::class_<CompiledMapping, std::shared_ptr<CompiledMapping>> cls(mod, "CompiledMapping");
+
+    cls.def(py::init<Mapping const &>(), "mapping"_a);
+
+    cls.def_property_readonly("nIn", &CompiledMapping::getNIn);
+    cls.def_property_readonly("nOut", &CompiledMapping::getNOut);
+    cls.def_property_readonly("nStages", &CompiledMapping::getNStages);
+
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &, Array2D const &>(&CompiledMapping::applyForward,
+                                                                     py::const_),
+            "from"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &>(&CompiledMapping::applyForward, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &, Array2D const &>(&CompiledMapping::applyInverse,
+                                                                     py::const_),
+            "from"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &>(&CompiledMapping::applyInverse, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+}
+
+}  // namespace
+}  // namespace ast
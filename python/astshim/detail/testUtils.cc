@@ -21,6 +21,7 @@
  */
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include "ndarray/pybind11.h"
 
 #include "astshim/detail/testUtils.h"
 
@@ -33,6 +34,11 @@ namespace {
 
 PYBIND11_MODULE(testUtils, mod) {
     mod.def("makeFrameDict", makeFrameDict);
+    mod.def("applyWithAst", applyWithAst, "mapping"_a, "from"_a, "doForward"_a);
+    mod.def("getPolyEvaluatorIds", py::overload_cast<Mapping const &>(&TestAccess::getPolyEvaluatorIds),
+            "mapping"_a);
+    mod.def("getPolyEvaluatorIds", py::overload_cast<MappingPool const &>(&TestAccess::getPolyEvaluatorIds),
+            "pool"_a);
 }
 
 }  // namespace
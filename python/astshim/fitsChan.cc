@@ -21,6 +21,7 @@
  */
 #include <complex>
 #include <memory>
+#include <stdexcept>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
@@ -75,6 +76,13 @@ PYBIND11_MODULE(fitsChan, mod) {
     wrapFoundValue<int>(mod, "I");
     wrapFoundValue<bool>(mod, "L");
 
+    py::class_<FitsCards> clsFitsCards(mod, "FitsCards");
+    clsFitsCards.def_readonly("names", &FitsCards::names);
+    clsFitsCards.def_readonly("types", &FitsCards::types);
+    clsFitsCards.def_readonly("values", &FitsCards::values);
+    clsFitsCards.def_readonly("comments", &FitsCards::comments);
+    clsFitsCards.def_readonly("cards", &FitsCards::cards);
+
     // Wrap FitsChan
     py::class_<FitsChan, std::shared_ptr<FitsChan>, Channel> cls(mod, "FitsChan");
 
@@ -107,6 +115,8 @@ PYBIND11_MODULE(fitsChan, mod) {
     cls.def("getFitsL", &FitsChan::getFitsL, "name"_a = "", "defval"_a = false);
     cls.def("getFitsS", &FitsChan::getFitsS, "name"_a = "", "defval"_a = "");
     cls.def("getAllCardNames", &FitsChan::getAllCardNames);
+    cls.def("getAllCardText", &FitsChan::getAllCardText);
+    cls.def("getAllCards", &FitsChan::getAllCards);
     cls.def("getAllWarnings", &FitsChan::getAllWarnings);
     cls.def("getCard", &FitsChan::getCard);
     cls.def("getCardComm", &FitsChan::getCardComm);
@@ -116,6 +126,15 @@ PYBIND11_MODULE(fitsChan, mod) {
     cls.def("purgeWcs", &FitsChan::purgeWcs);
     cls.def("putCards", &FitsChan::putCards, "cards"_a);
     cls.def("putFits", &FitsChan::putFits, "card"_a, "overwrite"_a);
+    cls.def("putHeader",
+            [](FitsChan &self, py::buffer header) {
+                py::buffer_info info = header.request();
+                if ((info.ndim != 1) || (info.itemsize != 1) || (info.strides[0] != 1)) {
+                    throw std::invalid_argument("header must be a contiguous buffer of bytes");
+                }
+                return self.putHeader(static_cast<char const *>(info.ptr), info.size);
+            },
+            "header"_a);
     cls.def("readFits", &FitsChan::readFits);
     cls.def("retainFits", &FitsChan::retainFits);
     cls.def("setFitsCF", &FitsChan::setFitsCF, "name"_a, "value"_a, "comment"_a = "", "overwrite"_a = false);
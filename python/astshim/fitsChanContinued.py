@@ -1,6 +1,6 @@
-__all__ = ["CardType", "FitsChan", "FitsKeyState"]
+__all__ = ["CardType", "FitsCards", "FitsChan", "FitsKeyState"]
 
-from .fitsChan import CardType, FitsChan, FitsKeyState
+from .fitsChan import CardType, FitsCards, FitsChan, FitsKeyState
 
 
 def _calc_card_pos(self, index):
@@ -118,7 +118,7 @@ def to_string(self):
     """A FitsChan string representation is a FITS header with newlines
     after each 80-character header card.
     """
-    return "\n".join(c for c in self)
+    return "\n".join(self.getAllCardText())
 
 
 FitsChan.__str__ = to_string
@@ -0,0 +1,50 @@
+/*
+ * LSST Data Management System
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ * See the COPYRIGHT file
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <memory>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "astshim/FitsWcsWriter.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace ast {
+namespace {
+
+PYBIND11_MODULE(fitsWcsWriter, mod) {
+    py::module::import("astshim.fitsChan");
+    py::module::import("astshim.frameSet");
+
+    py::class_<FitsWcsWriter, std::shared_ptr<FitsWcsWriter>> cls(mod, "FitsWcsWriter");
+
+    cls.def(py::init<FrameSet const &, std::vector<std::string> const &, std::string const &>(), "templ"_a,
+            "encodings"_a = std::vector<std::string>{"FITS-WCS"}, "options"_a = "");
+
+    cls.def_property_readonly("encoding", &FitsWcsWriter::getEncoding);
+
+    cls.def("write", &FitsWcsWriter::write, "frameSet"_a);
+}
+
+}  // namespace
+}  // namespace ast
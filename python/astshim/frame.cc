@@ -21,7 +21,9 @@
  */
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include "ndarray/pybind11.h"
 
+#include <utility>
 #include <vector>
 
 #include "astshim/CmpFrame.h"
@@ -103,12 +105,27 @@ PYBIND11_MODULE(frame, mod) {
     cls.def_property("title", &Frame::getTitle, &Frame::setTitle);
 
     cls.def("copy", &Frame::copy);
-    cls.def("angle", &Frame::angle, "a"_a, "b"_a, "c"_a);
-    cls.def("axAngle", &Frame::axAngle, "a"_a, "b"_a, "axis"_a);
+    // Wrap the single point versions of the geometry methods first, so that a sequence of numbers
+    // is taken to be one point. The GIL is released while the versions for arrays of points run.
+    cls.def("angle", py::overload_cast<PointD const &, PointD const &, PointD const &>(&Frame::angle, py::const_),
+            "a"_a, "b"_a, "c"_a);
+    cls.def("angle",
+            py::overload_cast<ConstArray2D const &, ConstArray2D const &, ConstArray2D const &>(&Frame::angle,
+                                                                                             py::const_),
+            "a"_a, "b"_a, "c"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("axAngle", py::overload_cast<PointD const &, PointD const &, int>(&Frame::axAngle, py::const_),
+            "a"_a, "b"_a, "axis"_a);
+    cls.def("axAngle",
+            py::overload_cast<ConstArray2D const &, ConstArray2D const &, int>(&Frame::axAngle, py::const_),
+            "a"_a, "b"_a, "axis"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("axDistance", &Frame::axDistance, "axis"_a, "v1"_a, "v2"_a);
     cls.def("axOffset", &Frame::axOffset, "axis"_a, "v1"_a, "dist"_a);
     cls.def("convert", &Frame::convert, "to"_a, "domainlist"_a = "");
-    cls.def("distance", &Frame::distance, "point1"_a, "point2"_a);
+    cls.def("distance", py::overload_cast<PointD const &, PointD const &>(&Frame::distance, py::const_),
+            "point1"_a, "point2"_a);
+    cls.def("distance",
+            py::overload_cast<ConstArray2D const &, ConstArray2D const &>(&Frame::distance, py::const_),
+            "points1"_a, "points2"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("findFrame", &Frame::findFrame, "template"_a, "domainlist"_a = "");
     cls.def("format", &Frame::format, "axis"_a, "value"_a);
     cls.def("getBottom", &Frame::getBottom, "axis"_a);
@@ -126,9 +143,26 @@ PYBIND11_MODULE(frame, mod) {
     cls.def("intersect", &Frame::intersect, "a1"_a, "a2"_a, "b1"_a, "b2"_a);
     cls.def("matchAxes", &Frame::matchAxes, "other"_a);
     cls.def("under", &Frame::under, "next"_a);
-    cls.def("norm", &Frame::norm, "value"_a);
-    cls.def("offset", &Frame::offset, "point1"_a, "point2"_a, "offset"_a);
-    cls.def("offset2", &Frame::offset2, "point1"_a, "angle"_a, "offset"_a);
+    cls.def("norm", py::overload_cast<PointD>(&Frame::norm, py::const_), "value"_a);
+    cls.def("norm", py::overload_cast<Array2D const &>(&Frame::norm, py::const_), "values"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("offset", py::overload_cast<PointD, PointD, double>(&Frame::offset, py::const_), "point1"_a,
+            "point2"_a, "offset"_a);
+    cls.def("offset",
+            py::overload_cast<ConstArray2D const &, ConstArray2D const &, ConstArray1D const &>(&Frame::offset,
+                                                                                             py::const_),
+            "points1"_a, "points2"_a, "offsets"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("offset2", py::overload_cast<PointD const &, double, double>(&Frame::offset2, py::const_),
+            "point1"_a, "angle"_a, "offset"_a);
+    cls.def("offset2",
+            [](Frame const &self, ConstArray2D const &points1, ConstArray1D const &angles,
+               ConstArray1D const &offsets) {
+                Array1D directions = ndarray::allocate(points1.getSize<1>());
+                Array2D points2 = ndarray::allocate(points1.getSize<0>(), points1.getSize<1>());
+                self.offset2(points1, angles, offsets, directions, points2);
+                return std::make_pair(directions, points2);
+            },
+            "points1"_a, "angles"_a, "offsets"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("permAxes", &Frame::permAxes, "perm"_a);
     cls.def("pickAxes", &Frame::pickAxes, "axes"_a);
     cls.def("resolve", &Frame::resolve, "point1"_a, "point2"_a, "point3"_a);
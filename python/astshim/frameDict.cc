@@ -91,6 +91,17 @@ PYBIND11_MODULE(frameDict, mod) {
             "copy"_a = true);
     cls.def("getFrame", py::overload_cast<std::string const &, bool>(&FrameDict::getFrame, py::const_),
             "domain"_a, "copy"_a = true);
+    // pybind11 cannot hold a pointer to const, so return a copy-on-write copy of each view
+    cls.def("getFrameView",
+            [](FrameDict const &self, int index) {
+                return std::static_pointer_cast<Frame>(self.getFrameView(index)->lazyCopy());
+            },
+            "index"_a);
+    cls.def("getFrameView",
+            [](FrameDict const &self, std::string const &domain) {
+                return std::static_pointer_cast<Frame>(self.getFrameView(domain)->lazyCopy());
+            },
+            "domain"_a);
     cls.def("getMapping", py::overload_cast<int, int>(&FrameDict::getMapping, py::const_),
             "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
     cls.def("getMapping", py::overload_cast<int, std::string const &>(&FrameDict::getMapping, py::const_),
@@ -100,6 +111,26 @@ PYBIND11_MODULE(frameDict, mod) {
     cls.def("getMapping",
             py::overload_cast<std::string const &, std::string const &>(&FrameDict::getMapping, py::const_),
             "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
+    cls.def("getMappingView",
+            [](FrameDict const &self, int from, int to) {
+                return std::static_pointer_cast<Mapping>(self.getMappingView(from, to)->lazyCopy());
+            },
+            "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
+    cls.def("getMappingView",
+            [](FrameDict const &self, int from, std::string const &to) {
+                return std::static_pointer_cast<Mapping>(self.getMappingView(from, to)->lazyCopy());
+            },
+            "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
+    cls.def("getMappingView",
+            [](FrameDict const &self, std::string const &from, int to) {
+                return std::static_pointer_cast<Mapping>(self.getMappingView(from, to)->lazyCopy());
+            },
+            "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
+    cls.def("getMappingView",
+            [](FrameDict const &self, std::string const &from, std::string const &to) {
+                return std::static_pointer_cast<Mapping>(self.getMappingView(from, to)->lazyCopy());
+            },
+            "from"_a = FrameDict::BASE, "to"_a = FrameDict::CURRENT);
     cls.def("getIndex", &FrameDict::getIndex, "domain"_a);
     cls.def("hasDomain", &FrameDict::hasDomain, "domain"_a);
     cls.def("mirrorVariants", py::overload_cast<int>(&FrameDict::mirrorVariants), "index"_a);
@@ -19,6 +19,8 @@
  * the GNU General Public License along with this program.  If not,
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
+#include <memory>
+
 #include <pybind11/pybind11.h>
 
 namespace py = pybind11;
@@ -26,6 +28,7 @@ using namespace pybind11::literals;
 
 #include "astshim/Frame.h"
 #include "astshim/FrameSet.h"
+#include "astshim/Mapping.h"
 
 namespace ast {
 namespace {
@@ -44,6 +47,7 @@ PYBIND11_MODULE(frameSet, mod) {
     cls.attr("BASE") = py::cast(AST__BASE);
     cls.attr("CURRENT") = py::cast(AST__CURRENT);
     cls.attr("NOFRAME") = py::cast(AST__NOFRAME);
+    cls.attr("MAPPING_CACHE_SIZE") = py::cast(FrameSet::MAPPING_CACHE_SIZE);
 
     cls.def_property("base", &FrameSet::getBase, &FrameSet::setBase);
     cls.def_property("current", &FrameSet::getCurrent, &FrameSet::setCurrent);
@@ -55,7 +59,20 @@ PYBIND11_MODULE(frameSet, mod) {
     cls.def("addVariant", &FrameSet::addVariant, "map"_a, "name"_a);
     cls.def("getAllVariants", &FrameSet::getAllVariants);
     cls.def("getFrame", &FrameSet::getFrame, "iframe"_a, "copy"_a = true);
+    // pybind11 cannot hold a pointer to const, so return a copy-on-write copy of each view
+    cls.def("getFrameView",
+            [](FrameSet const &self, int iframe) {
+                return std::static_pointer_cast<Frame>(self.getFrameView(iframe)->lazyCopy());
+            },
+            "iframe"_a);
     cls.def("getMapping", &FrameSet::getMapping, "from"_a = FrameSet::BASE, "to"_a = FrameSet::CURRENT);
+    cls.def("getMappingView",
+            [](FrameSet const &self, int from, int to) {
+                return std::static_pointer_cast<Mapping>(self.getMappingView(from, to)->lazyCopy());
+            },
+            "from"_a = FrameSet::BASE, "to"_a = FrameSet::CURRENT);
+    cls.def("getMappingCacheEnabled", &FrameSet::getMappingCacheEnabled);
+    cls.def("setMappingCacheEnabled", &FrameSet::setMappingCacheEnabled, "enable"_a);
     cls.def("getVariant", &FrameSet::getVariant);
     cls.def("mirrorVariants", &FrameSet::mirrorVariants, "iframe"_a);
     cls.def("remapFrame", &FrameSet::remapFrame, "iframe"_a, "map"_a);
@@ -24,6 +24,7 @@
 #include "ndarray/pybind11.h"
 
 #include "astshim/base.h"
+#include "astshim/CompiledMapping.h"
 #include "astshim/Mapping.h"
 #include "astshim/Object.h"
 #include "astshim/ParallelMap.h"
@@ -54,28 +55,69 @@ PYBIND11_MODULE(mapping, mod) {
     cls.def("copy", &Mapping::copy);
     cls.def("inverted", &Mapping::inverted);
     cls.def("linearApprox", &Mapping::linearApprox, "lbnd"_a, "ubnd"_a, "tol"_a);
+    cls.def("compiled", &Mapping::compiled);
     cls.def("then", &Mapping::then, "next"_a);
     cls.def("under", &Mapping::under, "next"_a);
     cls.def("rate", &Mapping::rate, "at"_a, "ax1"_a, "ax2"_a);
     cls.def("simplified", &Mapping::simplified);
-    // wrap the overloads of applyForward, applyInverse, tranGridForward and tranGridInverse that return a new
-    // result
-    cls.def("applyForward", py::overload_cast<ConstArray2D const &>(&Mapping::applyForward, py::const_),
-            "from"_a);
+    // wrap the overloads of applyForward, applyInverse, tranGridForward and tranGridInverse.
+    // The GIL is released while AST does the work, so Python threads can transform points concurrently;
+    // as always with AST, each thread must use its own objects (see Object.lock and Object.unlock).
+    // Arguments are converted, and results converted back, while the GIL is held.
     cls.def("applyForward",
-            py::overload_cast<std::vector<double> const &>(&Mapping::applyForward, py::const_), "from"_a);
-    cls.def("applyInverse", py::overload_cast<ConstArray2D const &>(&Mapping::applyInverse, py::const_),
-            "from"_a);
+            py::overload_cast<ConstArray2D const &, Array2D const &, bool>(&Mapping::applyForward, py::const_),
+            "from"_a, "to"_a, "badToNan"_a = true, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &, bool>(&Mapping::applyForward, py::const_), "from"_a,
+            "badToNan"_a = true, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &, Array2D const &, ndarray::Array<bool, 1, 1> const &>(
+                    &Mapping::applyForward, py::const_),
+            "from"_a, "to"_a, "isValid"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &, ndarray::Array<bool, 1, 1> const &>(&Mapping::applyForward,
+                                                                                        py::const_),
+            "from"_a, "isValid"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<std::vector<double> const &>(&Mapping::applyForward, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &, Array2D const &, bool>(&Mapping::applyInverse, py::const_),
+            "from"_a, "to"_a, "badToNan"_a = true, py::call_guard<py::gil_scoped_release>());
     cls.def("applyInverse",
-            py::overload_cast<std::vector<double> const &>(&Mapping::applyInverse, py::const_), "from"_a);
+            py::overload_cast<ConstArray2D const &, bool>(&Mapping::applyInverse, py::const_), "from"_a,
+            "badToNan"_a = true, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &, Array2D const &, ndarray::Array<bool, 1, 1> const &>(
+                    &Mapping::applyInverse, py::const_),
+            "from"_a, "to"_a, "isValid"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &, ndarray::Array<bool, 1, 1> const &>(&Mapping::applyInverse,
+                                                                                        py::const_),
+            "from"_a, "isValid"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<std::vector<double> const &>(&Mapping::applyInverse, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForwardStrided", &Mapping::applyForwardStrided, "from"_a, "to"_a, "badToNan"_a = true,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverseStrided", &Mapping::applyInverseStrided, "from"_a, "to"_a, "badToNan"_a = true,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("tranGridForward",
+            py::overload_cast<PointI const &, PointI const &, double, int, Array2D const &>(
+                    &Mapping::tranGridForward, py::const_),
+            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("tranGridForward",
             py::overload_cast<PointI const &, PointI const &, double, int, int>(&Mapping::tranGridForward,
                                                                                 py::const_),
-            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "nPoints"_a);
+            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "nPoints"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("tranGridInverse",
+            py::overload_cast<PointI const &, PointI const &, double, int, Array2D const &>(
+                    &Mapping::tranGridInverse, py::const_),
+            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("tranGridInverse",
             py::overload_cast<PointI const &, PointI const &, double, int, int>(&Mapping::tranGridInverse,
                                                                                 py::const_),
-            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "nPoints"_a);
+            "lbnd"_a, "ubnd"_a, "tol"_a, "maxpix"_a, "nPoints"_a, py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace
@@ -0,0 +1,64 @@
+/*
+ * LSST Data Management System
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ * See the COPYRIGHT file
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <pybind11/pybind11.h>
+#include "ndarray/pybind11.h"
+
+#include "astshim/base.h"
+#include "astshim/Mapping.h"
+#include "astshim/MappingPool.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace ast {
+namespace {
+
+PYBIND11_MODULE(mappingPool, mod) {
+    py::module::import("astshim.mapping");
+
+    py::class_<MappingPool, std::shared_ptr<MappingPool>> cls(mod, "MappingPool");
+
+    cls.def(py::init<Mapping const &, int>(), "mapping"_a, "nThreads"_a = 0);
+
+    cls.attr("MIN_POINTS_PER_THREAD") = py::cast(MappingPool::MIN_POINTS_PER_THREAD);
+
+    cls.def_property_readonly("nIn", &MappingPool::getNIn);
+    cls.def_property_readonly("nOut", &MappingPool::getNOut);
+    cls.def_property_readonly("nThreads", &MappingPool::getNThreads);
+
+    // release the GIL while transforming, so other Python threads can run
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &, Array2D const &>(&MappingPool::applyForward, py::const_),
+            "from"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyForward",
+            py::overload_cast<ConstArray2D const &>(&MappingPool::applyForward, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &, Array2D const &>(&MappingPool::applyInverse, py::const_),
+            "from"_a, "to"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("applyInverse",
+            py::overload_cast<ConstArray2D const &>(&MappingPool::applyInverse, py::const_), "from"_a,
+            py::call_guard<py::gil_scoped_release>());
+}
+
+}  // namespace
+}  // namespace ast
@@ -65,12 +65,16 @@ PYBIND11_MODULE(object, mod) {
     py::class_<Object, std::shared_ptr<Object>> cls(mod, "Object");
 
     cls.def_static("fromString", &Object::fromString);
+    cls.def_static("setCopyOnWrite", &Object::setCopyOnWrite, "enable"_a);
+    cls.def_static("getCopyOnWrite", &Object::getCopyOnWrite);
     // do not wrap fromAstObject because it uses a bare AST pointer
 
     cls.def("__str__", &Object::getClassName);
     cls.def("__repr__", [](Object const &self) { return "astshim." + self.getClassName(); });
     cls.def("__eq__", &Object::operator==, py::is_operator());
     cls.def("__ne__", &Object::operator!=, py::is_operator());
+    // objects are mutable, so they must not be hashable; use the hash method instead
+    cls.attr("__hash__") = py::none();
 
     cls.def_property_readonly("className", &Object::getClassName);
     cls.def_property("id", &Object::getID, &Object::setID);
@@ -81,6 +85,7 @@ PYBIND11_MODULE(object, mod) {
     cls.def("copy", &Object::copy);
     cls.def("clear", &Object::clear, "attrib"_a);
     cls.def("hasAttribute", &Object::hasAttribute, "attrib"_a);
+    cls.def("hash", &Object::hash);
     cls.def("getNObject", &Object::getNObject);
     cls.def("getRefCount", &Object::getRefCount);
     cls.def("lock", &Object::lock, "wait"_a);
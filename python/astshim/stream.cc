@@ -39,11 +39,15 @@ PYBIND11_MODULE(stream, mod) {
     clsStream.def(py::init<std::istream *, std::ostream *>(), "istream"_a, "ostream"_a);
     clsStream.def(py::init<>());
 
+    clsStream.attr("DEFAULT_SINK_BUFFER_SIZE") = py::cast(Stream::DEFAULT_SINK_BUFFER_SIZE);
+
     clsStream.def_property_readonly("isFits", &Stream::getIsFits);
     clsStream.def_property_readonly("hasStdStream", &Stream::hasStdStream);
+    clsStream.def_property("sinkBufferSize", &Stream::getSinkBufferSize, &Stream::setSinkBufferSize);
 
     clsStream.def("source", &Stream::source);
     clsStream.def("sink", &Stream::sink, "str"_a);
+    clsStream.def("flush", &Stream::flush);
 
     // FileStream
     py::class_<FileStream, std::shared_ptr<FileStream>, Stream> clsFileStream(mod, "FileStream");
@@ -52,6 +56,13 @@ PYBIND11_MODULE(stream, mod) {
 
     clsFileStream.def_property_readonly("path", &FileStream::getPath);
 
+    // MmapStream
+    py::class_<MmapStream, std::shared_ptr<MmapStream>, Stream> clsMmapStream(mod, "MmapStream");
+
+    clsMmapStream.def(py::init<std::string const &>(), "path"_a);
+
+    clsMmapStream.def_property_readonly("path", &MmapStream::getPath);
+
     // StringStream
     py::class_<StringStream, std::shared_ptr<StringStream>, Stream> clsStringStream(mod, "StringStream");
 
@@ -43,7 +43,8 @@ Channel::Channel(AstChannel *chan, Stream &stream, bool isFits)
 Channel::Channel(AstChannel *chan) : Object(reinterpret_cast<AstObject *>(chan)), _stream() { assertOK(); }
 
 Channel::~Channel() {
-    if (_stream.hasStdStream()) {
+    _stream.flush();
+    if (_stream.hasStdStream() || _stream._mappedFilePtr) {
         // avoid any attempt to read or write while the stream is being destroyed
         astPutChannelData(getRawPtr(), nullptr);
     }
@@ -60,7 +61,11 @@ std::shared_ptr<Object> Channel::read() {
 
 int Channel::write(Object const &object) {
     int ret = astWrite(getRawPtr(), object.getRawPtr());
+    bool isFlushed = flushStream();
     assertOK();
+    if (!isFlushed) {
+        throw std::runtime_error("Could not write to the stream of this channel");
+    }
     return ret;
 }
 
@@ -19,9 +19,12 @@
  * the GNU General Public License along with this program.  If not,
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
+#include "astshim/detail/polyEvaluator.h"
 #include "astshim/detail/polyMapUtils.h"
 #include "astshim/ChebyMap.h"
 
@@ -73,6 +76,58 @@ ChebyDomain ChebyMap::getDomain(bool forward) const {
     return ChebyDomain(lbnd, ubnd);
 }
 
+bool ChebyMap::tranNative(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward,
+                          int nToAxes, int toStride, double *to) const {
+    if (!_evaluatorsReady) {
+        _makeEvaluators();
+    }
+    auto const &evaluator = (doForward != isInverted()) ? _forwardEvaluator : _inverseEvaluator;
+    if (!evaluator) {
+        return false;
+    }
+    evaluator->apply(nPts, fromStride, from, toStride, to);
+    return true;
+}
+
+void ChebyMap::_makeEvaluators() const {
+    // Read the coefficients and domains from a copy that is not inverted,
+    // so there is no question which transform "forward" refers to
+    std::shared_ptr<Mapping> uninvertedCopy = isInverted() ? inverted() : nullptr;
+    auto rawMap = reinterpret_cast<AstChebyMap *>(
+            const_cast<AstObject *>(uninvertedCopy ? uninvertedCopy->getRawPtr() : getRawPtr()));
+    int const nIn = isInverted() ? getNOut() : getNIn();
+    int const nOut = isInverted() ? getNIn() : getNOut();
+
+    auto makeEvaluator = [&](bool forward) -> std::shared_ptr<detail::PolyEvaluator const> {
+        int const nEvalIn = forward ? nIn : nOut;
+        int const nEvalOut = forward ? nOut : nIn;
+        int nCoeffs = 0;
+        astPolyCoeffs(rawMap, static_cast<int>(forward), 0, nullptr, &nCoeffs);
+        assertOK();
+        if (nCoeffs == 0) {
+            return nullptr;
+        }
+        Array2D coeffs = ndarray::allocate(nCoeffs, 2 + nEvalIn);
+        astPolyCoeffs(rawMap, static_cast<int>(forward), nCoeffs * (2 + nEvalIn), coeffs.getData(),
+                      &nCoeffs);
+        assertOK();
+        std::vector<double> lbnd(nEvalIn, 0.0);
+        std::vector<double> ubnd(nEvalIn, 0.0);
+        // the domain stored with the coefficients (for a transform fit by polyTran, the bounds of the fit)
+        astChebyDomain(rawMap, static_cast<int>(forward), lbnd.data(), ubnd.data());
+        assertOK();
+        for (int axis = 0; axis < nEvalIn; ++axis) {
+            if (lbnd[axis] == AST__BAD || ubnd[axis] == AST__BAD || !(lbnd[axis] < ubnd[axis])) {
+                return nullptr;
+            }
+        }
+        return std::make_shared<detail::PolyEvaluator>(coeffs, nEvalIn, nEvalOut, lbnd, ubnd);
+    };
+    _forwardEvaluator = makeEvaluator(true);
+    _inverseEvaluator = makeEvaluator(false);
+    _evaluatorsReady = true;
+}
+
 /// Make a raw AstChebyMap with specified forward and inverse transforms.
 AstChebyMap *ChebyMap::_makeRawChebyMap(ConstArray2D const &coeff_f, ConstArray2D const &coeff_i,
                                         std::vector<double> const &lbnd_f, std::vector<double> const &ubnd_f,
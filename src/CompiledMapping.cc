@@ -0,0 +1,132 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "astshim/base.h"
+#include "astshim/detail/utils.h"
+#include "astshim/CompiledMapping.h"
+#include "astshim/Mapping.h"
+#include "astshim/SeriesMap.h"
+#include "astshim/ZoomMap.h"
+
+namespace ast {
+
+CompiledMapping::CompiledMapping(Mapping const &mapping)
+        : _nIn(mapping.getNIn()), _nOut(mapping.getNOut()), _maxAxes(std::max(_nIn, _nOut)), _stages() {
+    _addStages(*mapping.simplified(), false);
+}
+
+void CompiledMapping::_addStages(Mapping const &mapping, bool invert) {
+    std::string const className = mapping.getClassName();
+    if (className == "SeriesMap") {
+        auto const &seriesMap = dynamic_cast<SeriesMap const &>(mapping);
+        // the components are reported as they were when the SeriesMap was constructed,
+        // so if the SeriesMap is inverted then apply the inverse of each component in reverse order
+        bool const invertComponents = invert != seriesMap.isInverted();
+        auto const first = seriesMap[invertComponents ? 1 : 0];
+        auto const second = seriesMap[invertComponents ? 0 : 1];
+        _addStages(*first, invertComponents);
+        _addStages(*second, invertComponents);
+        return;
+    }
+    if (className == "UnitMap") {
+        return;
+    }
+
+    Stage stage;
+    stage.mapping = invert ? mapping.inverted() : mapping.copy();
+    stage.nIn = stage.mapping->getNIn();
+    stage.nOut = stage.mapping->getNOut();
+    stage.kind = StageKind::AST;
+    stage.zoom = 1.0;
+    stage.zoomInverted = false;
+    if (className == "ZoomMap") {
+        stage.kind = StageKind::ZOOM;
+        stage.zoom = dynamic_cast<ZoomMap const &>(*stage.mapping).getZoom();
+        stage.zoomInverted = stage.mapping->isInverted();
+    }
+    _maxAxes = std::max(_maxAxes, std::max(stage.nIn, stage.nOut));
+    _stages.push_back(std::move(stage));
+}
+
+void CompiledMapping::_tran(ConstArray2D const &from, bool doForward, Array2D const &to) const {
+    int const nFromAxes = doForward ? getNIn() : getNOut();
+    int const nToAxes = doForward ? getNOut() : getNIn();
+    detail::assertEqual(from.getSize<0>(), "from.size[0]", static_cast<std::size_t>(nFromAxes),
+                        "from coords");
+    detail::assertEqual(to.getSize<0>(), "to.size[0]", static_cast<std::size_t>(nToAxes), "to coords");
+    detail::assertEqual(from.getSize<1>(), "from.size[1]", to.getSize<1>(), "to.size[1]");
+    int const nPts = from.getSize<1>();
+    int const tileSize = Mapping::TILE_NPOINTS;
+
+    // Two tile buffers, with a stride of tileSize between axes; each stage that AST evaluates
+    // reads one and writes the other, and ZoomMap stages are evaluated in place
+    std::vector<double> bufferA(_maxAxes * tileSize);
+    std::vector<double> bufferB(_maxAxes * tileSize);
+    for (int tileBegin = 0; tileBegin < nPts; tileBegin += tileSize) {
+        int const tileEnd = std::min(nPts, tileBegin + tileSize);
+        int const tileNPoints = tileEnd - tileBegin;
+        double *curr = bufferA.data();
+        double *next = bufferB.data();
+        for (int axis = 0; axis < nFromAxes; ++axis) {
+            double const *fromRow = from.getData() + axis * from.getStride<0>();
+            detail::nanToAstBad(fromRow + tileBegin, fromRow + tileEnd, curr + axis * tileSize);
+        }
+
+        for (int i = 0; i < getNStages(); ++i) {
+            Stage const &stage = _stages[doForward ? i : getNStages() - 1 - i];
+            int const nStageFromAxes = doForward ? stage.nIn : stage.nOut;
+            int const nStageToAxes = doForward ? stage.nOut : stage.nIn;
+            if (stage.kind == StageKind::ZOOM) {
+                bool const divide = doForward == stage.zoomInverted;
+                for (int axis = 0; axis < nStageFromAxes; ++axis) {
+                    double *row = curr + axis * tileSize;
+                    if (divide) {
+                        for (double *ptr = row; ptr != row + tileNPoints; ++ptr) {
+                            *ptr = (*ptr == AST__BAD) ? AST__BAD : *ptr / stage.zoom;
+                        }
+                    } else {
+                        for (double *ptr = row; ptr != row + tileNPoints; ++ptr) {
+                            *ptr = (*ptr == AST__BAD) ? AST__BAD : *ptr * stage.zoom;
+                        }
+                    }
+                }
+            } else {
+                stage.mapping->_tranTile(tileNPoints, nStageFromAxes, tileSize, curr, doForward, nStageToAxes,
+                                         tileSize, next);
+                std::swap(curr, next);
+            }
+        }
+
+        for (int axis = 0; axis < nToAxes; ++axis) {
+            double *toRow = to.getData() + axis * to.getStride<0>();
+            std::copy(curr + axis * tileSize, curr + axis * tileSize + tileNPoints, toRow + tileBegin);
+            detail::astBadToNan(toRow + tileBegin, toRow + tileEnd);
+        }
+    }
+}
+
+}  // namespace ast
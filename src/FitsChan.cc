@@ -21,7 +21,10 @@
  */
 
 #include <complex>
+#include <cstring>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -39,6 +42,38 @@ namespace {
  */
 char const *cstrOrNull(std::string const &str) { return str.empty() ? nullptr : str.c_str(); }
 
+/**
+ * Walk once through all cards of a FitsChan, in order, then restore the current card
+ *
+ * For each card `readCard()` is called with that card current, then the text of the card is read
+ * and the next card made current by a single call to astFindFits.
+ *
+ * @return the text of each card
+ */
+template <typename ReadCard>
+std::vector<std::string> walkCards(FitsChan &fitsChan, ReadCard readCard) {
+    int const initialIndex = fitsChan.getCard();
+    int const numCards = fitsChan.getNCard();
+    std::vector<std::string> cards;
+    cards.reserve(numCards);
+    char card[detail::FITSLEN + 1];
+    try {
+        fitsChan.clearCard();
+        for (int i = 0; i < numCards && astOK; ++i) {
+            readCard();
+            card[0] = '\0';
+            astFindFits(fitsChan.getRawPtr(), "%f", card, true);
+            cards.emplace_back(card);
+        }
+        assertOK();
+    } catch (...) {
+        fitsChan.setCard(initialIndex);
+        throw;
+    }
+    fitsChan.setCard(initialIndex);
+    return cards;
+}
+
 }  // namespace
 
 FitsChan::FitsChan(Stream &stream, std::string const &options)
@@ -103,24 +138,78 @@ FoundValue<std::string> FitsChan::getFitsS(std::string const &name, std::string
     return FoundValue<std::string>(found, val);
 }
 
-std::vector<std::string> FitsChan::getAllCardNames() {
-    int const initialIndex = getCard();
-    int const numCards = getNCard();
-    std::vector<std::string> nameList;
-    nameList.reserve(numCards);
-    try {
-        for (auto i = 1; i <= numCards; ++i) {
-            setCard(i);
-            nameList.emplace_back(getCardName());
+int FitsChan::putHeader(char const *header, std::size_t size) {
+    if (size % detail::FITSLEN != 0) {
+        std::ostringstream os;
+        os << "header size = " << size << " is not a multiple of " << detail::FITSLEN;
+        throw std::invalid_argument(os.str());
+    }
+    astEmptyFits(getRawPtr());
+    assertOK();
+    int nCards = 0;
+    for (char const *card = header; card < header + size; card += detail::FITSLEN) {
+        if (std::strncmp(card, "END     ", 8) == 0) {
+            break;
         }
-    } catch (...) {
-        setCard(initialIndex);
-        throw;
+        // astPutFits uses at most 80 characters, so the card need not be null-terminated
+        astPutFits(getRawPtr(), card, 0);
+        if (!astOK) {
+            // do not leave a partly filled FitsChan; assertOK clears the AST status,
+            // which must be done first, else astEmptyFits does nothing
+            try {
+                assertOK();
+            } catch (std::runtime_error const &) {
+                astEmptyFits(getRawPtr());
+                astClearStatus;
+                throw;
+            }
+        }
+        ++nCards;
     }
-    setCard(initialIndex);
+    clearCard();
+    return nCards;
+}
+
+std::vector<std::string> FitsChan::getAllCardNames() {
+    std::vector<std::string> nameList;
+    nameList.reserve(getNCard());
+    walkCards(*this, [&]() {
+        char const *rawName = astGetC(getRawPtr(), "CardName");
+        nameList.emplace_back(rawName ? rawName : "");
+    });
     return nameList;
 }
 
+std::vector<std::string> FitsChan::getAllCardText() {
+    return walkCards(*this, []() {});
+}
+
+FitsCards FitsChan::getAllCards() {
+    int const numCards = getNCard();
+    FitsCards result;
+    result.names.reserve(numCards);
+    result.types.reserve(numCards);
+    result.values.reserve(numCards);
+    result.comments.reserve(numCards);
+    // AST returns strings in buffers that the next call may overwrite, so copy each at once
+    result.cards = walkCards(*this, [&]() {
+        char const *rawName = astGetC(getRawPtr(), "CardName");
+        result.names.emplace_back(rawName ? rawName : "");
+        auto type = static_cast<CardType>(astGetI(getRawPtr(), "CardType"));
+        result.types.push_back(type);
+        char const *rawComment = astGetC(getRawPtr(), "CardComm");
+        result.comments.emplace_back(rawComment ? rawComment : "");
+        char *rawValue = nullptr;
+        if (type == CardType::CONTINUE) {
+            astGetFitsCN(getRawPtr(), nullptr, &rawValue);
+        } else if ((type != CardType::COMMENT) && (type != CardType::UNDEF)) {
+            astGetFitsS(getRawPtr(), nullptr, &rawValue);
+        }
+        result.values.emplace_back(rawValue ? rawValue : "");
+    });
+    return result;
+}
+
 FoundValue<std::string> FitsChan::findFits(std::string const &name, bool inc) {
     std::unique_ptr<char[]> fitsbuf(new char[detail::FITSLEN + 1]);
     fitsbuf[0] = '\0';  // in case nothing is found
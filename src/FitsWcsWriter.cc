@@ -0,0 +1,83 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "astshim/base.h"
+#include "astshim/detail/utils.h"
+#include "astshim/FitsChan.h"
+#include "astshim/FitsWcsWriter.h"
+#include "astshim/FrameSet.h"
+#include "astshim/Stream.h"
+
+namespace ast {
+
+FitsWcsWriter::FitsWcsWriter(FrameSet const &templ, std::vector<std::string> const &encodings,
+                             std::string const &options)
+        : _fitsChan(), _encoding() {
+    if (encodings.empty()) {
+        throw std::invalid_argument("No encodings specified");
+    }
+    // the FitsChan needs no source or sink: headers are extracted from it and then it is emptied
+    Stream stream;
+    _fitsChan.reset(new FitsChan(stream, options));
+    if (_fitsChan->test("Encoding")) {
+        throw std::invalid_argument("options must not set Encoding; specify it using encodings instead");
+    }
+    for (auto const &encoding : encodings) {
+        _fitsChan->setEncoding(encoding);
+        bool isWritten = _fitsChan->write(templ) > 0;
+        _fitsChan->emptyFits();
+        if (isWritten) {
+            _encoding = encoding;
+            return;
+        }
+    }
+    std::ostringstream os;
+    os << "The template FrameSet cannot be written with any of the encodings:";
+    for (auto const &encoding : encodings) {
+        os << " " << encoding;
+    }
+    throw std::invalid_argument(os.str());
+}
+
+std::string FitsWcsWriter::write(FrameSet const &frameSet) {
+    int nObjects = _fitsChan->write(frameSet);
+    if (nObjects == 0) {
+        _fitsChan->emptyFits();
+        throw std::runtime_error("The FrameSet cannot be written with encoding " + _encoding);
+    }
+    std::string header;
+    header.reserve(_fitsChan->getNCard() * detail::FITSLEN);
+    _fitsChan->clearCard();
+    for (auto card = _fitsChan->findFits("%f", true); card.found; card = _fitsChan->findFits("%f", true)) {
+        header += card.value;
+        header.append(detail::FITSLEN - card.value.size(), ' ');
+    }
+    _fitsChan->emptyFits();
+    return header;
+}
+
+}  // namespace ast
@@ -19,6 +19,7 @@
  * the GNU General Public License along with this program.  If not,
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
+#include <cstddef>
 #include <stdexcept>
 #include <vector>
 
@@ -27,6 +28,154 @@
 #include "astshim/FrameSet.h"
 
 namespace ast {
+namespace {
+
+/*
+Copy one point from an array of points with dimensions (nAxes, nPoints)
+
+The batched geometry methods copy each point into a buffer allocated once per call,
+because AST wants the coordinates of a point to be contiguous.
+
+@param[in] points  Array of points
+@param[in] i  Index of point to copy
+@param[out] point  The point; must have length nAxes
+*/
+template <typename ArrayT>
+void copyPoint(ArrayT const &points, std::size_t i, std::vector<double> &point) {
+    auto const *data = points.getData() + i;
+    auto const stride = points.template getStride<0>();
+    for (auto &value : point) {
+        value = *data;
+        data += stride;
+    }
+}
+
+/*
+Copy one point into an array of points with dimensions (nAxes, nPoints); the inverse of copyPoint
+*/
+void storePoint(std::vector<double> const &point, Array2D const &points, std::size_t i) {
+    auto *data = points.getData() + i;
+    auto const stride = points.getStride<0>();
+    for (auto value : point) {
+        *data = value;
+        data += stride;
+    }
+}
+
+/*
+Replace `AST__BAD` with a quiet NaN in a 1-D array
+*/
+void astBadToNan(Array1D const &arr) { detail::astBadToNan(arr.getData(), arr.getData() + arr.getSize<0>()); }
+
+}  // namespace
+
+Array1D Frame::angle(ConstArray2D const &a, ConstArray2D const &b, ConstArray2D const &c) const {
+    std::size_t const nPoints = a.getSize<1>();
+    assertPointsShape(a, "a", nPoints);
+    assertPointsShape(b, "b", nPoints);
+    assertPointsShape(c, "c", nPoints);
+    Array1D result = ndarray::allocate(nPoints);
+    std::vector<double> pointA(getNIn()), pointB(getNIn()), pointC(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(a, i, pointA);
+        copyPoint(b, i, pointB);
+        copyPoint(c, i, pointC);
+        result[i] = astAngle(rawFrame, pointA.data(), pointB.data(), pointC.data());
+    }
+    assertOK();
+    astBadToNan(result);
+    return result;
+}
+
+Array1D Frame::axAngle(ConstArray2D const &a, ConstArray2D const &b, int axis) const {
+    std::size_t const nPoints = a.getSize<1>();
+    assertPointsShape(a, "a", nPoints);
+    assertPointsShape(b, "b", nPoints);
+    Array1D result = ndarray::allocate(nPoints);
+    std::vector<double> pointA(getNIn()), pointB(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(a, i, pointA);
+        copyPoint(b, i, pointB);
+        result[i] = astAxAngle(rawFrame, pointA.data(), pointB.data(), axis);
+    }
+    assertOK();
+    astBadToNan(result);
+    return result;
+}
+
+Array1D Frame::distance(ConstArray2D const &points1, ConstArray2D const &points2) const {
+    std::size_t const nPoints = points1.getSize<1>();
+    assertPointsShape(points1, "points1", nPoints);
+    assertPointsShape(points2, "points2", nPoints);
+    Array1D result = ndarray::allocate(nPoints);
+    std::vector<double> point1(getNIn()), point2(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(points1, i, point1);
+        copyPoint(points2, i, point2);
+        result[i] = astDistance(rawFrame, point1.data(), point2.data());
+    }
+    assertOK();
+    astBadToNan(result);
+    return result;
+}
+
+void Frame::norm(Array2D const &values) const {
+    std::size_t const nPoints = values.getSize<1>();
+    assertPointsShape(values, "values", nPoints);
+    std::vector<double> point(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(values, i, point);
+        astNorm(rawFrame, point.data());
+        storePoint(point, values, i);
+    }
+    assertOK();
+    detail::astBadToNan(values);
+}
+
+Array2D Frame::offset(ConstArray2D const &points1, ConstArray2D const &points2,
+                      ConstArray1D const &offsets) const {
+    std::size_t const nPoints = points1.getSize<1>();
+    assertPointsShape(points1, "points1", nPoints);
+    assertPointsShape(points2, "points2", nPoints);
+    detail::assertEqual(offsets.getSize<0>(), "offsets.size", nPoints, "number of points");
+    Array2D result = ndarray::allocate(getNIn(), nPoints);
+    std::vector<double> point1(getNIn()), point2(getNIn()), offsetPoint(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(points1, i, point1);
+        copyPoint(points2, i, point2);
+        astOffset(rawFrame, point1.data(), point2.data(), offsets[i], offsetPoint.data());
+        storePoint(offsetPoint, result, i);
+    }
+    assertOK();
+    detail::astBadToNan(result);
+    return result;
+}
+
+void Frame::offset2(ConstArray2D const &points1, ConstArray1D const &angles, ConstArray1D const &offsets,
+                    Array1D const &directions, Array2D const &points2) const {
+    detail::assertEqual(getNIn(), "naxes", 2, " cannot call offset2");
+    std::size_t const nPoints = points1.getSize<1>();
+    assertPointsShape(points1, "points1", nPoints);
+    assertPointsShape(points2, "points2", nPoints);
+    detail::assertEqual(angles.getSize<0>(), "angles.size", nPoints, "number of points");
+    detail::assertEqual(offsets.getSize<0>(), "offsets.size", nPoints, "number of points");
+    detail::assertEqual(directions.getSize<0>(), "directions.size", nPoints, "number of points");
+    std::vector<double> point1(getNIn()), point2(getNIn());
+    auto const *rawFrame = getRawPtr();
+    for (std::size_t i = 0; i < nPoints; ++i) {
+        copyPoint(points1, i, point1);
+        directions[i] = astOffset2(rawFrame, point1.data(), angles[i], offsets[i], point2.data());
+        storePoint(point2, points2, i);
+    }
+    assertOK();
+    astBadToNan(directions);
+    detail::astBadToNan(points2);
+}
 
 std::shared_ptr<FrameSet> Frame::convert(Frame const &to, std::string const &domainlist) {
     auto *rawFrameSet =
@@ -23,19 +23,104 @@
 #include <set>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "astshim/FrameDict.h"
 
 namespace ast {
+namespace {
+
+/*
+Get the domain of a frame in a FrameSet
+
+This reads the domain from the AST frame directly, rather than through a Frame constructed by
+FrameSet::getFrame, which would need a lookup of the frame's class to construct.
+
+@param[in] rawFrameSet  AST FrameSet
+@param[in] index  Index of frame; may be FrameSet::BASE or FrameSet::CURRENT
+*/
+std::string getFrameDomain(AstObject const *rawFrameSet, int index) {
+    auto *rawFrame = reinterpret_cast<AstObject *>(astGetFrame(rawFrameSet, index));
+    assertOK(rawFrame);
+    char const *rawDomain = astGetC(rawFrame, "Domain");
+    std::string domain = rawDomain ? rawDomain : "";
+    assertOK(rawFrame);
+    astAnnul(rawFrame);
+    return domain;
+}
+
+/*
+Throw std::runtime_error if AST failed to undo a failed change to a FrameDict
+
+@param[in] change  Description of the change, for the error message
+*/
+void assertUndoOK(std::string const &change) {
+    try {
+        assertOK();
+    } catch (std::runtime_error const &e) {
+        throw std::runtime_error("Could not undo failed " + change + ", so the FrameDict is inconsistent: " +
+                                 e.what());
+    }
+}
+
+}  // namespace
 
 void FrameDict::addFrame(int iframe, Mapping const &map, Frame const &frame) {
-    if (hasDomain(frame.getDomain())) {
-        throw std::invalid_argument("A frame already exists with domain " + frame.getDomain());
+    // The FrameSet is modified in place and the domain:index dict is updated incrementally,
+    // rather than modifying a deep copy and rebuilding the dict from it. To provide the strong
+    // exception guarantee, the domains of the new frames are checked before the FrameSet is modified,
+    // and the change to the FrameSet is undone if the dict cannot be updated.
+
+    // domains of the frames to be added: all frames of a FrameSet, else the one frame
+    std::vector<std::string> newDomains;
+    auto frameSetPtr = dynamic_cast<FrameSet const *>(&frame);
+    if (frameSetPtr) {
+        for (int index = 1, end = frameSetPtr->getNFrame(); index <= end; ++index) {
+            newDomains.emplace_back(getFrameDomain(frameSetPtr->getRawPtr(), index));
+        }
+    } else {
+        newDomains.emplace_back(frame.getDomain());
+    }
+    std::set<std::string> uniqueNewDomains;
+    for (auto const &domain : newDomains) {
+        if (domain.empty()) {
+            continue;
+        } else if (hasDomain(domain) || !uniqueNewDomains.insert(domain).second) {
+            throw std::invalid_argument("A frame already exists with domain " + domain);
+        }
+    }
+
+    int const nFrame = getNFrame();
+    int const current = getCurrent();
+    FrameSet::addFrame(iframe, map, frame);
+    std::unordered_map<std::string, int> newEntries;
+    try {
+        // read the domains of the new frames back from the FrameSet, rather than assume
+        // that AST appended the frames of a FrameSet in their original order
+        for (int index = nFrame + 1, end = getNFrame(); index <= end; ++index) {
+            auto const domain = getFrameDomain(getRawPtr(), index);
+            if (domain.empty()) {
+                continue;
+            } else if (hasDomain(domain) || newEntries.count(domain) > 0) {
+                throw std::invalid_argument("A frame already exists with domain " + domain);
+            }
+            newEntries[domain] = index;
+        }
+        _domainIndexDict.insert(newEntries.begin(), newEntries.end());
+    } catch (...) {
+        // undo the change: remove the new frames and restore the current frame
+        for (auto const &item : newEntries) {
+            _domainIndexDict.erase(item.first);
+        }
+        for (int index = getNFrame(); index > nFrame; --index) {
+            astRemoveFrame(getRawPtr(), index);
+        }
+        astSetI(getRawPtr(), "Current", current);
+        assertUndoOK("addFrame");
+        throw;
     }
-    auto copy = getFrameSet();
-    copy->addFrame(iframe, map, frame);
-    _update(*copy);
 }
 
 void FrameDict::addFrame(std::string const &domain, Mapping const &map, Frame const &frame) {
@@ -51,24 +136,60 @@ std::set<std::string> FrameDict::getAllDomains() const {
 }
 
 void FrameDict::removeFrame(int iframe) {
-    auto copy = getFrameSet();
-    copy->removeFrame(iframe);
-    _update(*copy);
+    int const index = iframe == BASE ? getBase() : (iframe == CURRENT ? getCurrent() : iframe);
+    // frames after the removed frame move down by one
+    std::unordered_map<std::string, int> newDict;
+    newDict.reserve(_domainIndexDict.size());
+    for (auto const &item : _domainIndexDict) {
+        if (item.second < index) {
+            newDict.emplace(item.first, item.second);
+        } else if (item.second > index) {
+            newDict.emplace(item.first, item.second - 1);
+        }
+    }
+    FrameSet::removeFrame(index);
+    _domainIndexDict.swap(newDict);
 }
 
 void FrameDict::removeFrame(std::string const &domain) { removeFrame(getIndex(domain)); }
 
 void FrameDict::setDomain(std::string const &domain) {
-    if (getDomain() == domain) {
+    std::string const oldDomain = getDomain();
+    if (oldDomain == detail::stringToUpper(domain)) {
         // null rename
         return;
     }
     if (hasDomain(domain)) {
         throw std::invalid_argument("Another framea already has domain name " + domain);
     }
-    auto copy = getFrameSet();
-    copy->setDomain(domain);
-    _update(*copy);
+    bool const wasSet = test("Domain");
+    int const current = getCurrent();
+    FrameSet::setDomain(domain);
+    try {
+        // read the domain back: AST converts it to uppercase, and clearing it restores the default
+        std::string const newDomain = getDomain();
+        std::unordered_map<std::string, int> newDict(_domainIndexDict);
+        auto oldIter = newDict.find(oldDomain);
+        if ((oldIter != newDict.end()) && (oldIter->second == current)) {
+            newDict.erase(oldIter);
+        }
+        if (!newDomain.empty()) {
+            if (newDict.count(newDomain) > 0) {
+                throw std::invalid_argument("Another frame already has domain name " + newDomain);
+            }
+            newDict[newDomain] = current;
+        }
+        _domainIndexDict.swap(newDict);
+    } catch (...) {
+        // undo the change
+        if (wasSet) {
+            astSetC(getRawPtr(), "Domain", oldDomain.c_str());
+        } else {
+            astClear(getRawPtr(), "Domain");
+        }
+        assertUndoOK("setDomain");
+        throw;
+    }
 }
 
 FrameDict::FrameDict(AstFrameSet *rawptr) : FrameSet(rawptr), _domainIndexDict() {
@@ -77,8 +198,10 @@ FrameDict::FrameDict(AstFrameSet *rawptr) : FrameSet(rawptr), _domainIndexDict()
 
 std::unordered_map<std::string, int> FrameDict::_makeNewDict(FrameSet const &frameSet) {
     std::unordered_map<std::string, int> dict;
-    for (int index = 1, end = frameSet.getNFrame(); index <= end; ++index) {
-        auto const domain = frameSet.getFrame(index, false)->getDomain();
+    int const nFrame = frameSet.getNFrame();
+    dict.reserve(nFrame);
+    for (int index = 1; index <= nFrame; ++index) {
+        auto const domain = getFrameDomain(frameSet.getRawPtr(), index);
         if (domain.empty()) {
             continue;
         } else if (dict.count(domain) > 0) {
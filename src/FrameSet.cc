@@ -20,6 +20,11 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
 #include "astshim/base.h"
 #include "astshim/FrameSet.h"
 
@@ -29,5 +34,52 @@ namespace ast {
 int constexpr FrameSet::BASE;
 int constexpr FrameSet::CURRENT;
 int constexpr FrameSet::NOFRAME;
+int constexpr FrameSet::MAPPING_CACHE_SIZE;
+
+std::shared_ptr<Mapping> FrameSet::getMapping(int from, int to) const {
+    if (_mappingCacheEnabled) {
+        // on a cache miss the cached mapping is the one AST returned, so this is the only copy
+        return getMappingView(from, to)->copy();
+    }
+    return Object::fromAstObject<Mapping>(_getRawMapping(from, to), true);
+}
+
+std::shared_ptr<Mapping const> FrameSet::getMappingView(int from, int to) const {
+    // Resolve BASE and CURRENT so that equivalent requests share a cache entry
+    int const fromIndex = from == BASE ? getBase() : (from == CURRENT ? getCurrent() : from);
+    int const toIndex = to == BASE ? getBase() : (to == CURRENT ? getCurrent() : to);
+    auto const key = std::make_pair(fromIndex, toIndex);
+    if (_mappingCacheEnabled) {
+        auto it = std::find_if(_mappingCache.begin(), _mappingCache.end(),
+                               [&key](decltype(_mappingCache)::const_reference entry) {
+                                   return entry.first == key;
+                               });
+        if (it != _mappingCache.end()) {
+            return it->second;
+        }
+    }
+    // the view is a shallow copy of part of this FrameSet
+    preventSharing();
+    // AST returns a new mapping, though it may share components with this FrameSet,
+    // which AST does not modify in place; it is returned as const, so it need not be copied
+    std::shared_ptr<Mapping const> mapping =
+            Object::fromAstObject<Mapping>(_getRawMapping(fromIndex, toIndex), false);
+    if (_mappingCacheEnabled) {
+        if (_mappingCache.size() >= static_cast<std::size_t>(MAPPING_CACHE_SIZE)) {
+            _mappingCache.erase(_mappingCache.begin());
+        }
+        _mappingCache.emplace_back(key, mapping);
+    }
+    return mapping;
+}
+
+AstObject *FrameSet::_getRawMapping(int from, int to) const {
+    AstObject *rawMap = reinterpret_cast<AstObject *>(astGetMapping(getRawPtr(), from, to));
+    assertOK(rawMap);
+    if (!rawMap) {
+        throw std::runtime_error("getMapping failed (returned a null mapping)");
+    }
+    return rawMap;
+}
 
 }  // namespace ast
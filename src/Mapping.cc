@@ -19,13 +19,16 @@
  * the GNU General Public License along with this program.  If not,
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include "astshim/base.h"
+#include "astshim/CompiledMapping.h"
 #include "astshim/detail/utils.h"
 #include "astshim/Frame.h"
 #include "astshim/Mapping.h"
@@ -34,6 +37,8 @@
 
 namespace ast {
 
+CompiledMapping Mapping::compiled() const { return CompiledMapping(*this); }
+
 SeriesMap Mapping::then(Mapping const &next) const { return SeriesMap(*this, next); }
 
 ParallelMap Mapping::under(Mapping const &next) const { return ParallelMap(*this, next); }
@@ -69,6 +74,9 @@ std::shared_ptr<Class> Mapping::decompose(int i, bool copy) const {
     }
     // Report pre-existing problems now so our later test for "not a compound object" is accurate
     assertOK();
+    if (!copy) {
+        preventSharing();
+    }
 
     AstMapping *rawMap1;
     AstMapping *rawMap2;
@@ -109,21 +117,127 @@ std::shared_ptr<Class> Mapping::decompose(int i, bool copy) const {
     return Object::fromAstObject<Class>(reinterpret_cast<AstObject *>(retRawMap), copy);
 }
 
-void Mapping::_tran(ConstArray2D const &from, bool doForward, Array2D const &to) const {
+void Mapping::_tran(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to,
+                    bool badToNan) const {
+    int const nFromAxes = doForward ? getNIn() : getNOut();
+    int const nToAxes = doForward ? getNOut() : getNIn();
+    detail::assertEqual(from.getSize<0>(), "from.size[0]", static_cast<std::size_t>(nFromAxes),
+                        "from coords");
+    detail::assertEqual(to.getSize<0>(), "to.size[0]", static_cast<std::size_t>(nToAxes), "to coords");
+    detail::assertEqual(from.getSize<1>(), "from.size[1]", to.getSize<1>(), "to.size[1]");
+    _tranRange(from, doForward, to, 0, from.getSize<1>(), badToNan);
+}
+
+void Mapping::_tran(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to,
+                    ndarray::Array<bool, 1, 1> const &isValid) const {
     int const nFromAxes = doForward ? getNIn() : getNOut();
     int const nToAxes = doForward ? getNOut() : getNIn();
     detail::assertEqual(from.getSize<0>(), "from.size[0]", static_cast<std::size_t>(nFromAxes),
                         "from coords");
     detail::assertEqual(to.getSize<0>(), "to.size[0]", static_cast<std::size_t>(nToAxes), "to coords");
     detail::assertEqual(from.getSize<1>(), "from.size[1]", to.getSize<1>(), "to.size[1]");
-    int const nPts = from.getSize<1>();
-    // astTranN treats 0 points as an error and the call isn't needed anyway
-    if (nPts > 0) {
-        astTranN(getRawPtr(), nPts, nFromAxes, nPts, from.getData(), static_cast<int>(doForward), nToAxes, nPts,
-                 to.getData());
+    detail::assertEqual(isValid.getSize<0>(), "isValid.size", from.getSize<1>(), "from.size[1]");
+    _tranRange(from, doForward, to, 0, from.getSize<1>(), true, isValid.getData());
+}
+
+void Mapping::_tranRange(ConstStridedArray2D const &from, bool doForward, StridedArray2D const &to, int begin,
+                         int end, bool badToNan, bool *isValid) const {
+    int const nFromAxes = from.getSize<0>();
+    int const nToAxes = to.getSize<0>();
+    auto const fromPointStride = from.getStride<1>();
+    auto const toPointStride = to.getStride<1>();
+    // AST requires the values for each axis to be contiguous; if they are not then copy each tile
+    std::vector<double> fromTileBuffer;  // copy of a tile of `from` with nan replaced by AST__BAD, if needed
+    std::vector<double> toTileBuffer;    // a tile of `to`, if the values for each axis are not contiguous
+    if (toPointStride != 1) {
+        toTileBuffer.resize(nToAxes * TILE_NPOINTS);
+    }
+    // If each call is costly and no copy is needed then transform all points with one call;
+    // otherwise use tiles, so that each tile of output is converted while it is in the cache
+    int maxTileNPoints = TILE_NPOINTS;
+    bool mayHaveNan = true;
+    if (fromPointStride == 1 && toPointStride == 1 && hasCostlyTranCall()) {
+        mayHaveNan = false;
+        for (int axis = 0; axis < nFromAxes && !mayHaveNan; ++axis) {
+            double const *fromRow = from.getData() + axis * from.getStride<0>();
+            mayHaveNan = detail::hasNanOrInf(fromRow + begin, fromRow + end);
+        }
+        if (!mayHaveNan) {
+            maxTileNPoints = std::max(end - begin, 1);
+        }
+    }
+    // astTranN treats 0 points as an error and the call isn't needed anyway,
+    // so there is no call if begin = end
+    for (int tileBegin = begin; tileBegin < end; tileBegin += maxTileNPoints) {
+        int const tileEnd = std::min(end, tileBegin + maxTileNPoints);
+        int const tileNPoints = tileEnd - tileBegin;
+
+        // the "dim" arguments of astTranN are the stride between axes,
+        // which lets AST work on a subset of the columns
+        double const *fromTile = from.getData() + tileBegin;
+        int fromTileStride = from.getStride<0>();
+        bool copyFrom = fromPointStride != 1;
+        for (int axis = 0; axis < nFromAxes && mayHaveNan && !copyFrom; ++axis) {
+            double const *fromRow = from.getData() + axis * from.getStride<0>();
+            copyFrom = detail::hasNanOrInf(fromRow + tileBegin, fromRow + tileEnd);
+        }
+        if (copyFrom) {
+            fromTileBuffer.resize(nFromAxes * TILE_NPOINTS);
+            for (int axis = 0; axis < nFromAxes; ++axis) {
+                double const *fromRow = from.getData() + axis * from.getStride<0>();
+                double *fromBufferRow = fromTileBuffer.data() + axis * TILE_NPOINTS;
+                if (fromPointStride == 1) {
+                    detail::nanToAstBad(fromRow + tileBegin, fromRow + tileEnd, fromBufferRow);
+                } else {
+                    for (int i = 0; i < tileNPoints; ++i) {
+                        double const val = fromRow[(tileBegin + i) * fromPointStride];
+                        fromBufferRow[i] = std::isnan(val) ? AST__BAD : val;
+                    }
+                }
+            }
+            fromTile = fromTileBuffer.data();
+            fromTileStride = TILE_NPOINTS;
+        }
+
+        double *toTile = to.getData() + tileBegin;
+        int toTileStride = to.getStride<0>();
+        if (toPointStride != 1) {
+            toTile = toTileBuffer.data();
+            toTileStride = TILE_NPOINTS;
+        }
+
+        _tranTile(tileNPoints, nFromAxes, fromTileStride, fromTile, doForward, nToAxes, toTileStride, toTile);
+
+        if (isValid) {
+            std::fill(isValid + tileBegin, isValid + tileEnd, true);
+        }
+        for (int axis = 0; axis < nToAxes; ++axis) {
+            double *toTileRow = toTile + axis * toTileStride;
+            if (isValid) {
+                detail::updateIsValid(toTileRow, toTileRow + tileNPoints, isValid + tileBegin);
+            }
+            if (badToNan) {
+                detail::astBadToNan(toTileRow, toTileRow + tileNPoints);
+            }
+            if (toPointStride != 1) {
+                double *toRow = to.getData() + axis * to.getStride<0>();
+                for (int i = 0; i < tileNPoints; ++i) {
+                    toRow[(tileBegin + i) * toPointStride] = toTileRow[i];
+                }
+            }
+        }
     }
     assertOK();
-    detail::astBadToNan(to);
+}
+
+void Mapping::_tranTile(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward,
+                        int nToAxes, int toStride, double *to) const {
+    if (tranNative(nPts, nFromAxes, fromStride, from, doForward, nToAxes, toStride, to)) {
+        return;
+    }
+    astTranN(getRawPtr(), nPts, nFromAxes, fromStride, from, static_cast<int>(doForward), nToAxes, toStride,
+             to);
+    assertOK();
 }
 
 void Mapping::_tranGrid(PointI const &lbnd, PointI const &ubnd, double tol, int maxpix, bool doForward,
@@ -140,6 +254,9 @@ void Mapping::_tranGrid(PointI const &lbnd, PointI const &ubnd, double tol, int
     detail::astBadToNan(to);
 }
 
+// Make sure the constant has an address, since std::min takes its arguments by reference
+int constexpr Mapping::TILE_NPOINTS;
+
 // Explicit instantiations
 template std::shared_ptr<Frame> Mapping::decompose(int i, bool) const;
 template std::shared_ptr<Mapping> Mapping::decompose(int i, bool) const;
@@ -0,0 +1,120 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "astshim/base.h"
+#include "astshim/detail/utils.h"
+#include "astshim/Mapping.h"
+#include "astshim/MappingPool.h"
+
+namespace ast {
+
+// Make sure the constant has an address; needed for pybind11
+int constexpr MappingPool::MIN_POINTS_PER_THREAD;
+
+MappingPool::MappingPool(Mapping const &mapping, int nThreads)
+        : _nIn(mapping.getNIn()), _nOut(mapping.getNOut()), _copies() {
+    if (nThreads < 0) {
+        std::ostringstream os;
+        os << "nThreads = " << nThreads << " must be >= 0";
+        throw std::invalid_argument(os.str());
+    }
+    if (nThreads == 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    _copies.reserve(nThreads);
+    for (int i = 0; i < nThreads; ++i) {
+        auto copy = mapping.copy();
+        // each copy is locked by whichever thread uses it, so leave it unlocked when idle
+        copy->unlock();
+        _copies.push_back(copy);
+    }
+}
+
+MappingPool::~MappingPool() {
+    // AST objects must be locked by the thread that annuls them
+    for (auto &copy : _copies) {
+        try {
+            copy->lock(true);
+        } catch (...) {
+            // can't throw in a destructor; the object will be leaked by AST instead
+        }
+    }
+}
+
+void MappingPool::_tran(ConstArray2D const &from, bool doForward, Array2D const &to) const {
+    int const nFromAxes = doForward ? getNIn() : getNOut();
+    int const nToAxes = doForward ? getNOut() : getNIn();
+    detail::assertEqual(from.getSize<0>(), "from.size[0]", static_cast<std::size_t>(nFromAxes),
+                        "from coords");
+    detail::assertEqual(to.getSize<0>(), "to.size[0]", static_cast<std::size_t>(nToAxes), "to coords");
+    detail::assertEqual(from.getSize<1>(), "from.size[1]", to.getSize<1>(), "to.size[1]");
+    int const nPts = from.getSize<1>();
+    int const nThreads = std::max(
+            1, std::min(getNThreads(), (nPts + MIN_POINTS_PER_THREAD - 1) / MIN_POINTS_PER_THREAD));
+    int const nPtsPerThread = (nPts + nThreads - 1) / nThreads;
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto transformRange = [&](int i) {
+        int const begin = std::min(nPts, i * nPtsPerThread);
+        int const end = std::min(nPts, begin + nPtsPerThread);
+        Mapping &copy = *_copies[i];
+        try {
+            copy.lock(true);
+            try {
+                copy._tranRange(from, doForward, to, begin, end, true);
+            } catch (...) {
+                copy.unlock();
+                throw;
+            }
+            copy.unlock();
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    // use the calling thread for the first range of points
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (int i = 1; i < nThreads; ++i) {
+        threads.emplace_back(transformRange, i);
+    }
+    transformRange(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto const &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace ast
@@ -20,12 +20,15 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include <algorithm>
-#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "astshim/base.h"
 #include "astshim/detail/utils.h"
@@ -68,68 +71,206 @@ namespace ast {
 
 namespace {
 
+// Is copy-on-write enabled? See Object::setCopyOnWrite
+std::atomic<bool> copyOnWriteEnabled(false);
+
 /**
-C function to sink data to an ostream
+Receive the text that AST writes for an object, line by line, for Object::operator== and Object::hash
+
+The text is the same as that written by `Object::show(false)`, with each line terminated by a newline.
+*/
+class ContentSink {
+public:
+    enum class Mode {
+        RECORD,   ///< record the text
+        COMPARE,  ///< compare the text to recorded text
+        HASH      ///< compute the 64-bit FNV-1a hash of the text
+    };
+
+    /**
+    Construct a ContentSink
+
+    @param[in] mode  What to do with the text
+    @param[in] recordedText  Recorded text to compare against; required if mode is COMPARE
+    */
+    explicit ContentSink(Mode mode, std::string const *recordedText = nullptr)
+            : _mode(mode), _recordedText(recordedText) {}
+
+    /**
+    Process one line of text written by AST
+
+    In mode COMPARE, once a line differs from the recorded text this sets the AST error status,
+    to make AST stop writing; see @ref isAborted.
+    */
+    void addLine(char const *text) {
+        std::size_t const len = std::strlen(text);
+        switch (_mode) {
+            case Mode::RECORD:
+                _text.append(text, len);
+                _text.push_back('\n');
+                break;
+            case Mode::COMPARE:
+                if (_isEqual) {
+                    _isEqual = _pos + len < _recordedText->size() &&
+                               _recordedText->compare(_pos, len, text, len) == 0 &&
+                               (*_recordedText)[_pos + len] == '\n';
+                    _pos += len + 1;
+                    if (!_isEqual) {
+                        _isAborted = true;
+                        astSetStatus(AST__ATGER);
+                    }
+                }
+                break;
+            case Mode::HASH:
+                for (std::size_t i = 0; i < len; ++i) {
+                    _addToHash(static_cast<unsigned char>(text[i]));
+                }
+                _addToHash('\n');
+                break;
+        }
+    }
+
+    /// Get the recorded text (mode RECORD)
+    std::string const &getText() const { return _text; }
+
+    /// Return true if all the text matched the recorded text (mode COMPARE)
+    bool isEqual() const { return _isEqual && _pos == _recordedText->size(); }
+
+    /// Return true if this sink set the AST error status to stop AST writing (mode COMPARE)
+    bool isAborted() const { return _isAborted; }
 
-This function uses the macro astChannelData as thread-safe way to retrieve a pointer to the ostream.
-As such, code using this function must call `astPutChannelData(ch, &os)` to save a pointer
-to the ostream `os` in the channel `ch` before calling `astWrite(ch, obj)`.
+    /// Get the hash (mode HASH)
+    std::uint64_t getHash() const { return _hash; }
+
+private:
+    void _addToHash(unsigned char c) {
+        _hash ^= c;
+        _hash *= 1099511628211ULL;  // 64-bit FNV prime
+    }
+
+    Mode _mode;
+    std::string const *_recordedText;
+    std::string _text;
+    bool _isEqual = true;
+    bool _isAborted = false;
+    std::size_t _pos = 0;
+    std::uint64_t _hash = 14695981039346656037ULL;  // 64-bit FNV offset basis
+};
+
+/**
+C function to sink data to a ContentSink
+
+This function uses the macro astChannelData as thread-safe way to retrieve a pointer to the ContentSink.
+*/
+extern "C" void sinkToContent(const char *text) {
+    auto sinkPtr = reinterpret_cast<ContentSink *>(astChannelData);
+    sinkPtr->addLine(text);
+}
+
+/**
+Write an object to a ContentSink, using the same channel options as `Object::show(false)`
 */
-extern "C" void sinkToOstream(const char *text) {
-    auto osptr = reinterpret_cast<std::ostream *>(astChannelData);
-    (*osptr) << text << std::endl;
+void writeContent(Object const &object, ContentSink &sink) {
+    auto rawChan = astChannel(nullptr, sinkToContent, "%s", "Comment=0");
+    assertOK(reinterpret_cast<AstObject *>(rawChan));
+    astPutChannelData(rawChan, &sink);
+    astWrite(rawChan, object.getRawPtr());
+    if (sink.isAborted()) {
+        // The error status was set by the sink, to stop writing early, so it is not an error;
+        // clear the status and discard any messages AST reported while it stopped
+        try {
+            assertOK();
+        } catch (std::runtime_error const &) {
+        }
+    }
+    assertOK(reinterpret_cast<AstObject *>(rawChan));
+    astAnnul(rawChan);
+    assertOK();
 }
 
 }  // anonymous namespace
 
 bool Object::operator==(Object const &rhs) const {
-    auto thisStr = this->show(false);
-    auto rhsStr = rhs.show(false);
-    return rhsStr == thisStr;
+    if (same(rhs)) {
+        return true;
+    }
+    if (getClassName() != rhs.getClassName()) {
+        return false;
+    }
+    ContentSink thisSink(ContentSink::Mode::RECORD);
+    writeContent(*this, thisSink);
+    ContentSink rhsSink(ContentSink::Mode::COMPARE, &thisSink.getText());
+    writeContent(rhs, rhsSink);
+    return rhsSink.isEqual();
+}
+
+std::uint64_t Object::_computeHash() const {
+    ContentSink sink(ContentSink::Mode::HASH);
+    writeContent(*this, sink);
+    return sink.getHash();
 }
 
 std::shared_ptr<Object> Object::_basicFromAstObject(AstObject *rawObj) {
-    static std::unordered_map<std::string, std::function<std::shared_ptr<Object>(AstObject *)>>
-            ClassCasterMap = {
-                    {"ChebyMap", makeShim<ChebyMap, AstChebyMap>},
-                    {"CmpFrame", makeShim<CmpFrame, AstCmpFrame>},
-                    {"FitsChan", makeShim<FitsChan, AstFitsChan>},
-                    {"FitsTable", makeShim<FitsTable, AstFitsTable>},
-                    {"Frame", makeShim<Frame, AstFrame>},
-                    {"FrameSet", makeShim<FrameSet, AstFrameSet>},
-                    {"FrameDict", makeShim<FrameDict, AstFrameSet>},
-                    {"KeyMap", makeShim<KeyMap, AstKeyMap>},
-                    {"LutMap", makeShim<LutMap, AstLutMap>},
-                    {"MathMap", makeShim<MathMap, AstMathMap>},
-                    {"MatrixMap", makeShim<MatrixMap, AstMatrixMap>},
-                    {"NormMap", makeShim<NormMap, AstNormMap>},
-                    {"ParallelMap", makeShim<ParallelMap, AstCmpMap>},
-                    {"PcdMap", makeShim<PcdMap, AstPcdMap>},
-                    {"PermMap", makeShim<PermMap, AstPermMap>},
-                    {"PolyMap", makeShim<PolyMap, AstPolyMap>},
-                    {"RateMap", makeShim<RateMap, AstRateMap>},
-                    {"SeriesMap", makeShim<SeriesMap, AstCmpMap>},
-                    {"ShiftMap", makeShim<ShiftMap, AstShiftMap>},
-                    {"SkyFrame", makeShim<SkyFrame, AstSkyFrame>},
-                    {"SlaMap", makeShim<SlaMap, AstSlaMap>},
-                    {"SpecFrame", makeShim<SpecFrame, AstSpecFrame>},
-                    {"SphMap", makeShim<SphMap, AstSphMap>},
-                    {"TimeFrame", makeShim<TimeFrame, AstTimeFrame>},
-                    {"Table", makeShim<Table, AstTable>},
-                    {"TimeMap", makeShim<TimeMap, AstTimeMap>},
-                    {"TranMap", makeShim<TranMap, AstTranMap>},
-                    {"UnitMap", makeShim<UnitMap, AstUnitMap>},
-                    {"UnitNormMap", makeShim<UnitNormMap, AstUnitNormMap>},
-                    {"WcsMap", makeShim<WcsMap, AstWcsMap>},
-                    {"WinMap", makeShim<WinMap, AstWinMap>},
-                    {"ZoomMap", makeShim<ZoomMap, AstZoomMap>},
-            };
+    using Caster = std::shared_ptr<Object> (*)(AstObject *);
+    using NameCaster = std::pair<char const *, Caster>;
+    // Sorted by AST class name, for a binary search on the name returned by astGetC without copying it
+    static std::vector<NameCaster> const nameCasterList = [] {
+        std::vector<NameCaster> list = {
+                {"ChebyMap", makeShim<ChebyMap, AstChebyMap>},
+                // AST only reports whether a CmpMap is in series by decomposing it,
+                // so do that once here, and use the constructors that do not check again
+                {"CmpMap",
+                 [](AstObject *p) -> std::shared_ptr<Object> {
+                     auto rawCmpMap = reinterpret_cast<AstCmpMap *>(p);
+                     if (detail::isSeries(rawCmpMap)) {
+                         return std::shared_ptr<SeriesMap>(new SeriesMap(rawCmpMap, CmpMap::SeriesChecked()));
+                     }
+                     return std::shared_ptr<ParallelMap>(new ParallelMap(rawCmpMap, CmpMap::SeriesChecked()));
+                 }},
+                {"CmpFrame", makeShim<CmpFrame, AstCmpFrame>},
+                {"FitsChan", makeShim<FitsChan, AstFitsChan>},
+                {"FitsTable", makeShim<FitsTable, AstFitsTable>},
+                {"Frame", makeShim<Frame, AstFrame>},
+                {"FrameSet", makeShim<FrameSet, AstFrameSet>},
+                {"KeyMap", makeShim<KeyMap, AstKeyMap>},
+                {"LutMap", makeShim<LutMap, AstLutMap>},
+                {"MathMap", makeShim<MathMap, AstMathMap>},
+                {"MatrixMap", makeShim<MatrixMap, AstMatrixMap>},
+                {"NormMap", makeShim<NormMap, AstNormMap>},
+                {"PcdMap", makeShim<PcdMap, AstPcdMap>},
+                {"PermMap", makeShim<PermMap, AstPermMap>},
+                {"PolyMap", makeShim<PolyMap, AstPolyMap>},
+                {"RateMap", makeShim<RateMap, AstRateMap>},
+                {"ShiftMap", makeShim<ShiftMap, AstShiftMap>},
+                {"SkyFrame", makeShim<SkyFrame, AstSkyFrame>},
+                {"SlaMap", makeShim<SlaMap, AstSlaMap>},
+                {"SpecFrame", makeShim<SpecFrame, AstSpecFrame>},
+                {"SphMap", makeShim<SphMap, AstSphMap>},
+                {"Table", makeShim<Table, AstTable>},
+                {"TimeFrame", makeShim<TimeFrame, AstTimeFrame>},
+                {"TimeMap", makeShim<TimeMap, AstTimeMap>},
+                {"TranMap", makeShim<TranMap, AstTranMap>},
+                {"UnitMap", makeShim<UnitMap, AstUnitMap>},
+                {"UnitNormMap", makeShim<UnitNormMap, AstUnitNormMap>},
+                {"WcsMap", makeShim<WcsMap, AstWcsMap>},
+                {"WinMap", makeShim<WinMap, AstWinMap>},
+                {"ZoomMap", makeShim<ZoomMap, AstZoomMap>},
+        };
+        std::sort(list.begin(), list.end(), [](NameCaster const &a, NameCaster const &b) {
+            return std::strcmp(a.first, b.first) < 0;
+        });
+        return list;
+    }();
     assertOK(rawObj);
-    auto className = detail::getClassName(rawObj);
-    auto name_caster = ClassCasterMap.find(className);
-    if (name_caster == ClassCasterMap.end()) {
+    char const *className = astGetC(rawObj, "Class");
+    assertOK(rawObj);
+    auto name_caster = std::lower_bound(
+            nameCasterList.begin(), nameCasterList.end(), className,
+            [](NameCaster const &a, char const *name) { return std::strcmp(a.first, name) < 0; });
+    if (name_caster == nameCasterList.end() || std::strcmp(name_caster->first, className) != 0) {
+        std::string const name = className ? className : "";
         astAnnul(rawObj);
-        throw std::runtime_error("Class " + className + " not supported");
+        throw std::runtime_error("Class " + name + " not supported");
     }
     return name_caster->second(rawObj);
 }
@@ -168,6 +309,51 @@ std::string Object::show(bool showComments) const {
     return os.str();
 }
 
+void Object::setCopyOnWrite(bool enable) { copyOnWriteEnabled = enable; }
+
+bool Object::getCopyOnWrite() { return copyOnWriteEnabled; }
+
+AstObject *Object::_shareOrCopyRawPtr(bool &shared) const {
+    // Only share an AST object that is unshared or shared purely through copy-on-write;
+    // sharing one that is also held elsewhere (e.g. inside a FrameSet) would let changes
+    // made through this object or its copy leak into the other holder.
+    // Also do not share an object with an ID, since astCopy does not copy the ID.
+    shared = copyOnWriteEnabled && !_neverShare &&
+             (_copyOnWrite || astGetI(getRawPtr(), "RefCount") == 1) && !astTest(getRawPtr(), "ID");
+    assertOK();
+    if (!shared) {
+        return getRawPtrCopy();
+    }
+    _copyOnWrite = true;
+    AstObject *rawPtrClone = reinterpret_cast<AstObject *>(astClone(_objPtr.get()));
+    assertOK(rawPtrClone);
+    return rawPtrClone;
+}
+
+std::shared_ptr<Object> Object::lazyCopy() const {
+    bool const hasId = astTest(getRawPtr(), "ID");
+    assertOK();
+    if (_neverShare || hasId) {
+        return copy();
+    }
+    AstObject *rawPtrClone = reinterpret_cast<AstObject *>(astClone(_objPtr.get()));
+    assertOK(rawPtrClone);
+    auto result = _basicFromAstObject(rawPtrClone);
+    result->_copyOnWrite = true;
+    _copyOnWrite = true;
+    return result;
+}
+
+void Object::_makeUnique() const {
+    if (astGetI(_objPtr.get(), "RefCount") > 1) {
+        AstObject *rawPtrCopy = reinterpret_cast<AstObject *>(astCopy(_objPtr.get()));
+        assertOK(rawPtrCopy);
+        _objPtr.reset(rawPtrCopy);
+    }
+    assertOK();
+    _copyOnWrite = false;
+}
+
 Object::Object(AstObject *object) : _objPtr(object, &detail::annulAstObject) {
     assertOK();
     if (!object) {
@@ -19,9 +19,11 @@
  * the GNU General Public License along with this program.  If not,
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 
+#include "astshim/detail/polyEvaluator.h"
 #include "astshim/detail/polyMapUtils.h"
 #include "astshim/PolyMap.h"
 
@@ -55,6 +57,52 @@ PolyMap::PolyMap(AstPolyMap *map) : Mapping(reinterpret_cast<AstMapping *>(map))
     }
 }
 
+bool PolyMap::tranNative(int nPts, int nFromAxes, int fromStride, double const *from, bool doForward,
+                         int nToAxes, int toStride, double *to) const {
+    if (!_evaluatorsReady) {
+        _makeEvaluators();
+    }
+    auto const &evaluator = (doForward != isInverted()) ? _forwardEvaluator : _inverseEvaluator;
+    if (!evaluator) {
+        return false;
+    }
+    evaluator->apply(nPts, fromStride, from, toStride, to);
+    return true;
+}
+
+void PolyMap::_makeEvaluators() const {
+    // Read the coefficients from a copy that is not inverted,
+    // so there is no question which transform "forward" refers to
+    std::shared_ptr<Mapping> uninvertedCopy = isInverted() ? inverted() : nullptr;
+    auto rawMap = reinterpret_cast<AstPolyMap *>(
+            const_cast<AstObject *>(uninvertedCopy ? uninvertedCopy->getRawPtr() : getRawPtr()));
+    int const nIn = isInverted() ? getNOut() : getNIn();
+    int const nOut = isInverted() ? getNIn() : getNOut();
+    bool const iterInverse = getIterInverse();
+
+    auto makeEvaluator = [&](bool forward) -> std::shared_ptr<detail::PolyEvaluator const> {
+        if (!forward && iterInverse) {
+            return nullptr;
+        }
+        int const nEvalIn = forward ? nIn : nOut;
+        int const nEvalOut = forward ? nOut : nIn;
+        int nCoeffs = 0;
+        astPolyCoeffs(rawMap, static_cast<int>(forward), 0, nullptr, &nCoeffs);
+        assertOK();
+        if (nCoeffs == 0) {
+            return nullptr;
+        }
+        Array2D coeffs = ndarray::allocate(nCoeffs, 2 + nEvalIn);
+        astPolyCoeffs(rawMap, static_cast<int>(forward), nCoeffs * (2 + nEvalIn), coeffs.getData(),
+                      &nCoeffs);
+        assertOK();
+        return std::make_shared<detail::PolyEvaluator>(coeffs, nEvalIn, nEvalOut);
+    };
+    _forwardEvaluator = makeEvaluator(true);
+    _inverseEvaluator = makeEvaluator(false);
+    _evaluatorsReady = true;
+}
+
 /// Make a raw AstPolyMap with specified forward and inverse transforms.
 AstPolyMap *PolyMap::_makeRawPolyMap(ConstArray2D const &coeff_f, ConstArray2D const &coeff_i,
                                      std::string const &options) const {
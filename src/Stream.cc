@@ -0,0 +1,133 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "astshim/base.h"
+#include "astshim/detail/utils.h"
+#include "astshim/Stream.h"
+
+namespace ast {
+namespace detail {
+
+/**
+A file mapped read-only into memory, and the position of the next data to source from it
+*/
+class MappedFile {
+public:
+    /**
+    Map a file
+
+    @param[in] path  Path to file
+
+    @throws std::runtime_error if the file cannot be opened or mapped
+    */
+    explicit MappedFile(std::string const &path) : data(nullptr), size(0), pos(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            _throwError("Failed to open", path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            _throwError("Failed to get the size of", path);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                _throwError("Failed to map", path);
+            }
+            data = static_cast<char const *>(addr);
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) {
+            ::munmap(const_cast<char *>(data), size);
+        }
+    }
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    char const *data;  ///< start of the mapped data
+    std::size_t size;  ///< size of the mapped data, in bytes
+    std::size_t pos;   ///< offset of the next data to source
+
+private:
+    [[noreturn]] static void _throwError(char const *what, std::string const &path) {
+        std::ostringstream os;
+        os << what << " file \"" << path << "\": " << std::strerror(errno);
+        throw std::runtime_error(os.str());
+    }
+};
+
+}  // namespace detail
+
+// Make sure the constant has an address; needed for pybind11
+std::size_t constexpr Stream::DEFAULT_SINK_BUFFER_SIZE;
+
+char const *Stream::_sourceMapped() {
+    auto &file = *_mappedFilePtr;
+    if (file.pos >= file.size) {
+        return nullptr;
+    }
+    char const *begin = file.data + file.pos;
+    std::size_t remaining = file.size - file.pos;
+    if (_isFits) {
+        if (remaining < detail::FITSLEN) {
+            file.pos = file.size;
+            return nullptr;
+        }
+        _sourceStr.assign(begin, detail::FITSLEN);
+        file.pos += detail::FITSLEN;
+        return _sourceStr.c_str();
+    }
+    // copy the line, rather than terminate it in place, so the mapping is never written to;
+    // _sourceStr keeps its capacity, so this rarely allocates
+    auto newline = static_cast<char const *>(std::memchr(begin, '\n', remaining));
+    std::size_t const lineLen = newline ? static_cast<std::size_t>(newline - begin) : remaining;
+    _sourceStr.assign(begin, lineLen);
+    file.pos = newline ? file.pos + lineLen + 1 : file.size;
+    return _sourceStr.c_str();
+}
+
+MmapStream::MmapStream(std::string const &path) : Stream(), _path(path) {
+    _mappedFilePtr = std::make_shared<detail::MappedFile>(path);
+}
+
+}  // namespace ast
@@ -8,10 +8,17 @@
 namespace ast {
 namespace {
 
-static std::ostringstream errorMsgStream;
+/*
+Buffer for AST error messages
+
+This is thread-local because AST keeps a separate error status for each thread
+and calls the error handler from the thread in which the error occurred,
+so each thread collects (and clears) only its own messages.
+*/
+thread_local std::ostringstream errorMsgStream;
 
 /*
-Write an error message to `errorMsgStream`
+Write an error message to `errorMsgStream` for the calling thread
 
 Intended to be registered as an error handler to AST by calling `astSetPutErr(reportError)`.
 */
@@ -47,8 +54,8 @@ public:
 }  // namespace
 
 void assertOK(AstObject *rawPtr1, AstObject *rawPtr2) {
-    // Construct ErrorHandler once, the first time this function is called.
-    // This is done to initialize `errorMsgStream` and register `reportError` as the AST error handler.
+    // Construct ErrorHandler once, the first time this function is called (by any thread).
+    // This is done to register `reportError` as the AST error handler.
     // See https://isocpp.org/wiki/faq/ctors#static-init-order-on-first-use
     static ErrorHandler *errHandler = new ErrorHandler();
     if (!astOK) {
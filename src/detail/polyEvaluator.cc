@@ -0,0 +1,252 @@
+/*
+ * LSST Data Management System
+ * Copyright 2017 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "astshim/base.h"
+#include "astshim/detail/polyEvaluator.h"
+#include "astshim/detail/utils.h"
+
+namespace ast {
+namespace detail {
+
+// Make sure the constant has an address, since std::min takes its arguments by reference
+int constexpr PolyEvaluator::BLOCK_NPOINTS;
+
+PolyEvaluator::PolyEvaluator(ConstArray2D const &coeffs, int nIn, int nOut)
+        : _nIn(nIn),
+          _nOut(nOut),
+          _isChebyshev(false),
+          _lbnd(),
+          _ubnd(),
+          _scale(),
+          _offset(),
+          _maxPower(nIn, 0),
+          _powerRow0(nIn, 0),
+          _nPowerRows(0),
+          _terms(),
+          _factorRows() {
+    _init(coeffs, {}, {});
+}
+
+PolyEvaluator::PolyEvaluator(ConstArray2D const &coeffs, int nIn, int nOut, std::vector<double> const &lbnd,
+                             std::vector<double> const &ubnd)
+        : _nIn(nIn),
+          _nOut(nOut),
+          _isChebyshev(true),
+          _lbnd(),
+          _ubnd(),
+          _scale(),
+          _offset(),
+          _maxPower(nIn, 0),
+          _powerRow0(nIn, 0),
+          _nPowerRows(0),
+          _terms(),
+          _factorRows() {
+    _init(coeffs, lbnd, ubnd);
+}
+
+void PolyEvaluator::_init(ConstArray2D const &coeffs, std::vector<double> const &lbnd,
+                          std::vector<double> const &ubnd) {
+    int const nIn = _nIn;
+    int const nOut = _nOut;
+    if (_isChebyshev) {
+        assertEqual(lbnd.size(), "lbnd.size", static_cast<std::size_t>(nIn), "nIn");
+        assertEqual(ubnd.size(), "ubnd.size", static_cast<std::size_t>(nIn), "nIn");
+        _lbnd = lbnd;
+        _ubnd = ubnd;
+        // Compute the scale and offset that normalize x to x' = x * scale + offset in [-1, 1]
+        for (int axis = 0; axis < nIn; ++axis) {
+            double const width = ubnd[axis] - lbnd[axis];
+            _scale.push_back(2.0 / width);
+            _offset.push_back(-(ubnd[axis] + lbnd[axis]) / width);
+        }
+    }
+
+    int const nCoeffs = coeffs.getSize<0>();
+    if (nCoeffs > 0 && coeffs.getSize<1>() != static_cast<std::size_t>(2 + nIn)) {
+        std::ostringstream os;
+        os << "coeffs row length = " << coeffs.getSize<1>() << " != 2 + nIn = " << 2 + nIn;
+        throw std::invalid_argument(os.str());
+    }
+
+    // Parse the coefficients into (coeff, out, powers) and find the maximum power of each axis
+    std::vector<std::vector<int>> powersList(nCoeffs);
+    std::vector<int> outList(nCoeffs);
+    for (int i = 0; i < nCoeffs; ++i) {
+        outList[i] = static_cast<int>(std::lround(coeffs[i][1])) - 1;
+        if (outList[i] < 0 || outList[i] >= nOut) {
+            std::ostringstream os;
+            os << "coeffs[" << i << "] output index = " << outList[i] + 1 << " not in range [1, " << nOut
+               << "]";
+            throw std::invalid_argument(os.str());
+        }
+        powersList[i].resize(nIn);
+        for (int axis = 0; axis < nIn; ++axis) {
+            int const power = static_cast<int>(std::lround(coeffs[i][2 + axis]));
+            if (power < 0) {
+                std::ostringstream os;
+                os << "coeffs[" << i << "] power for axis " << axis << " = " << power << " < 0";
+                throw std::invalid_argument(os.str());
+            }
+            powersList[i][axis] = power;
+            _maxPower[axis] = std::max(_maxPower[axis], power);
+        }
+    }
+
+    // The table of basis functions holds rows x^1, x^2, ... x^maxPower (or T_1(x'), T_2(x')...)
+    // for each input axis x
+    for (int axis = 0; axis < nIn; ++axis) {
+        _powerRow0[axis] = _nPowerRows;
+        _nPowerRows += _maxPower[axis];
+    }
+
+    // Sort the terms by output axis, preserving order within an axis
+    std::vector<int> order(nCoeffs);
+    for (int i = 0; i < nCoeffs; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&outList](int a, int b) { return outList[a] < outList[b]; });
+    _terms.reserve(nCoeffs);
+    for (int i : order) {
+        Term term;
+        term.coeff = coeffs[i][0];
+        term.out = outList[i];
+        term.factorBegin = static_cast<int>(_factorRows.size());
+        for (int axis = 0; axis < nIn; ++axis) {
+            int const power = powersList[i][axis];
+            if (power > 0) {
+                _factorRows.push_back(_powerRow0[axis] + power - 1);
+            }
+        }
+        term.factorEnd = static_cast<int>(_factorRows.size());
+        _terms.push_back(term);
+    }
+}
+
+void PolyEvaluator::apply(int nPts, int fromStride, double const *from, int toStride, double *to) const {
+    std::vector<double> powers(std::max(_nPowerRows, 1) * BLOCK_NPOINTS);
+    std::vector<double> product(BLOCK_NPOINTS);
+    std::vector<char> isBad(BLOCK_NPOINTS);
+    std::vector<double> normX(_isChebyshev ? BLOCK_NPOINTS : 0);  // normalized input for one axis
+    for (int blockBegin = 0; blockBegin < nPts; blockBegin += BLOCK_NPOINTS) {
+        int const blockNPoints = std::min(nPts, blockBegin + BLOCK_NPOINTS) - blockBegin;
+
+        // Compute the table of basis functions and note which points have bad input
+        std::fill(isBad.begin(), isBad.end(), 0);
+        for (int axis = 0; axis < _nIn; ++axis) {
+            double const *x = from + axis * fromStride + blockBegin;
+            for (int j = 0; j < blockNPoints; ++j) {
+                isBad[j] |= (x[j] == AST__BAD);
+            }
+            if (_isChebyshev) {
+                // Points outside the domain are bad; test x rather than x' so the bounds are inclusive.
+                // Then normalize x to x' in [-1, 1] and use that from now on.
+                double *normRow = normX.data();
+                for (int j = 0; j < blockNPoints; ++j) {
+                    isBad[j] |= (x[j] < _lbnd[axis]) | (x[j] > _ubnd[axis]);
+                    normRow[j] = x[j] * _scale[axis] + _offset[axis];
+                }
+                x = normRow;
+            }
+            if (_maxPower[axis] == 0) {
+                continue;
+            }
+            double *row = powers.data() + _powerRow0[axis] * BLOCK_NPOINTS;
+            std::copy(x, x + blockNPoints, row);
+            if (_isChebyshev) {
+                // T_2(x) = 2 x T_1(x) - T_0(x), where T_0(x) = 1
+                if (_maxPower[axis] >= 2) {
+                    double const *prevRow = row;
+                    row += BLOCK_NPOINTS;
+                    for (int j = 0; j < blockNPoints; ++j) {
+                        row[j] = 2.0 * x[j] * prevRow[j] - 1.0;
+                    }
+                }
+                for (int order = 3; order <= _maxPower[axis]; ++order) {
+                    double const *prevRow = row;
+                    double const *prevPrevRow = row - BLOCK_NPOINTS;
+                    row += BLOCK_NPOINTS;
+                    for (int j = 0; j < blockNPoints; ++j) {
+                        row[j] = 2.0 * x[j] * prevRow[j] - prevPrevRow[j];
+                    }
+                }
+            } else {
+                for (int power = 2; power <= _maxPower[axis]; ++power) {
+                    double const *prevRow = row;
+                    row += BLOCK_NPOINTS;
+                    for (int j = 0; j < blockNPoints; ++j) {
+                        row[j] = prevRow[j] * x[j];
+                    }
+                }
+            }
+        }
+
+        // Accumulate the terms
+        for (int outAxis = 0; outAxis < _nOut; ++outAxis) {
+            double *out = to + outAxis * toStride + blockBegin;
+            std::fill(out, out + blockNPoints, 0.0);
+        }
+        for (Term const &term : _terms) {
+            double *out = to + term.out * toStride + blockBegin;
+            int const nFactors = term.factorEnd - term.factorBegin;
+            if (nFactors == 0) {
+                for (int j = 0; j < blockNPoints; ++j) {
+                    out[j] += term.coeff;
+                }
+            } else if (nFactors == 1) {
+                double const *row = powers.data() + _factorRows[term.factorBegin] * BLOCK_NPOINTS;
+                for (int j = 0; j < blockNPoints; ++j) {
+                    out[j] += term.coeff * row[j];
+                }
+            } else {
+                double const *row = powers.data() + _factorRows[term.factorBegin] * BLOCK_NPOINTS;
+                for (int j = 0; j < blockNPoints; ++j) {
+                    product[j] = term.coeff * row[j];
+                }
+                for (int f = term.factorBegin + 1; f < term.factorEnd; ++f) {
+                    row = powers.data() + _factorRows[f] * BLOCK_NPOINTS;
+                    for (int j = 0; j < blockNPoints; ++j) {
+                        product[j] *= row[j];
+                    }
+                }
+                for (int j = 0; j < blockNPoints; ++j) {
+                    out[j] += product[j];
+                }
+            }
+        }
+
+        // Set all outputs of points with bad input to AST__BAD
+        for (int outAxis = 0; outAxis < _nOut; ++outAxis) {
+            double *out = to + outAxis * toStride + blockBegin;
+            for (int j = 0; j < blockNPoints; ++j) {
+                out[j] = isBad[j] ? AST__BAD : out[j];
+            }
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace ast
@@ -25,12 +25,11 @@ namespace ast {
 namespace detail {
 
 void astBadToNan(ast::Array2D const &arr) {
-    for (auto i = arr.begin(); i != arr.end(); ++i) {
-        for (auto j = i->begin(); j != i->end(); ++j) {
-            if (*j == AST__BAD) {
-                *j = std::numeric_limits<double>::quiet_NaN();
-            }
-        }
+    // each row is contiguous, so process it as a simple range that the compiler can vectorize
+    int const nCols = arr.getSize<1>();
+    for (std::size_t row = 0; row < arr.getSize<0>(); ++row) {
+        double *rowData = arr.getData() + row * arr.getStride<0>();
+        astBadToNan(rowData, rowData + nCols);
     }
 }
 
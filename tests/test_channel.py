@@ -39,6 +39,83 @@ class TestChannel(MappingTestCase):
         os.remove(path1)
         os.remove(path2)
 
+    def test_ChannelMmapStream(self):
+        path = os.path.join(self.dataDir, "channelMmapStream.txt")
+
+        zoommap = ast.ZoomMap(2, 0.1, "ID=Hello there")
+        frameSet = ast.FrameSet(ast.Frame(2), zoommap, ast.SkyFrame())
+        outstream = ast.FileStream(path, True)
+        outchan = ast.Channel(outstream)
+        self.assertEqual(outchan.write(zoommap), 1)
+        self.assertEqual(outchan.write(frameSet), 1)
+        del outchan
+        del outstream
+        with open(path) as infile:
+            initialText = infile.read()
+
+        instream = ast.MmapStream(path)
+        self.assertEqual(instream.path, path)
+        inchan = ast.Channel(instream)
+        self.assertEqual(inchan.read().show(), zoommap.show())
+        self.assertEqual(inchan.read(), frameSet)
+        with self.assertRaises(RuntimeError):
+            inchan.read()
+        del inchan
+        del instream
+
+        # the file is not modified by reading it
+        with open(path) as infile:
+            self.assertEqual(infile.read(), initialText)
+
+        # a last line with no newline is read
+        with open(path, "w") as outfile:
+            outfile.write(zoommap.show().rstrip("\n"))
+        inchan = ast.Channel(ast.MmapStream(path))
+        self.assertEqual(inchan.read().show(), zoommap.show())
+        del inchan
+        os.remove(path)
+
+        with self.assertRaises(RuntimeError):
+            ast.MmapStream(path)
+
+    def test_ChannelSinkBuffer(self):
+        """Test that buffered output is complete after each write
+        """
+        zoommap = ast.ZoomMap(2, 0.1, "ID=Hello there")
+        frameSet = ast.FrameSet(ast.Frame(2), zoommap, ast.SkyFrame())
+        for bufferSize in (0, 1, 100, ast.Stream.DEFAULT_SINK_BUFFER_SIZE):
+            with self.subTest(bufferSize=bufferSize):
+                ss = ast.StringStream()
+                self.assertEqual(ss.sinkBufferSize, ast.Stream.DEFAULT_SINK_BUFFER_SIZE)
+                ss.sinkBufferSize = bufferSize
+                self.assertEqual(ss.sinkBufferSize, bufferSize)
+                channel = ast.Channel(ss, "Comment=0")
+                self.assertEqual(channel.write(zoommap), 1)
+                self.assertEqual(ss.getSinkData(), zoommap.show(False))
+                self.assertEqual(channel.write(frameSet), 1)
+                self.assertEqual(ss.getSinkData(), zoommap.show(False) + frameSet.show(False))
+
+                ss.sinkToSource()
+                self.assertEqual(channel.read().show(), zoommap.show())
+                self.assertEqual(channel.read(), frameSet)
+
+    def test_StringStreamSinkBuffer(self):
+        """Test that data sunk directly to a StringStream is seen at once
+        by getSinkData and sinkToSource, however it is buffered
+        """
+        for bufferSize in (0, 100, ast.Stream.DEFAULT_SINK_BUFFER_SIZE):
+            with self.subTest(bufferSize=bufferSize):
+                ss = ast.StringStream()
+                ss.sinkBufferSize = bufferSize
+                self.assertTrue(ss.sink("x"))
+                self.assertEqual(ss.getSinkData(), "x\n")
+                self.assertTrue(ss.sink("y"))
+                self.assertEqual(ss.getSinkData(), "x\ny\n")
+                self.assertTrue(ss.sink("z"))
+                ss.sinkToSource()
+                self.assertEqual(ss.getSourceData(), "x\ny\nz\n")
+                self.assertEqual(ss.getSinkData(), "")
+
     def test_ChannelStringStream(self):
         ss = ast.StringStream()
         channel = ast.Channel(ss)
@@ -5,6 +5,7 @@ from numpy.polynomial.chebyshev import chebval, chebval2d
 import numpy.testing as npt
 
 import astshim as ast
+from astshim.detail.testUtils import applyWithAst, getPolyEvaluatorIds
 from astshim.test import MappingTestCase
 
 
@@ -365,6 +366,24 @@ class TestChebyMap(MappingTestCase):
         roundTripIn3 = chebyMap3.applyInverse(outdata)
         npt.assert_allclose(roundTripIn3, roundTripIn2)
 
+        # the inverse fit by polyTran is evaluated natively over the domain AST stored for it:
+        # compare to AST at many points in (and on the bounds of) that domain, and just outside it
+        rng = np.random.RandomState(5)
+        for chebyMap in (chebyMap2, chebyMap3):
+            domain_i = chebyMap.getDomain(False)
+            nPts = 1000
+            indata_i = np.array([rng.uniform(lb, ub, size=nPts)
+                                 for lb, ub in zip(domain_i.lbnd, domain_i.ubnd)])
+            indata_i[:, 0] = domain_i.lbnd
+            indata_i[:, 1] = domain_i.ubnd
+            indata_i[0, 2] = domain_i.lbnd[0] - 0.01
+            indata_i[1, 3] = domain_i.ubnd[1] + 0.01
+            outdata_i = chebyMap.applyInverse(indata_i)
+            astOutdata_i = applyWithAst(chebyMap, indata_i, False)
+            npt.assert_allclose(outdata_i, astOutdata_i, atol=1e-12, equal_nan=True)
+            self.assertTrue(np.all(np.isnan(outdata_i[:, 2:4])))
+            self.assertFalse(np.any(np.isnan(outdata_i[:, 0:2])))
+
     def test_ChebyMapChebyMapUnivertible(self):
         """Test polyTran on a ChebyMap without a single-valued inverse
         """
@@ -506,6 +525,59 @@ class TestChebyMap(MappingTestCase):
             result = cmp2.simplified()
             self.assertIsInstance(result, ast.UnitMap)
 
+    def test_ChebyMapHighOrder(self):
+        """Test evaluation of a high order ChebyMap against numpy
+        and against AST itself, for many points, including points
+        outside the domain
+        """
+        rng = np.random.RandomState(7)
+        order = 7
+        lbnd_f = [-2.0, 10.0]
+        ubnd_f = [1.5, 30.0]
+        c1 = np.zeros((order + 1, order + 1))
+        c2 = np.zeros((order + 1, order + 1))
+        coeffList = []
+        for i in range(order + 1):
+            for j in range(order + 1 - i):
+                c1[i, j] = rng.uniform(-1, 1)
+                c2[i, j] = rng.uniform(-1, 1)
+                coeffList.append([c1[i, j], 1, i, j])
+                coeffList.append([c2[i, j], 2, i, j])
+        coeff_f = np.array(coeffList)
+        chebyMap = ast.ChebyMap(coeff_f, 2, lbnd_f, ubnd_f)
+
+        nPts = 10000  # more than one tile of points
+        indata = np.array([
+            rng.uniform(lbnd_f[0], ubnd_f[0], size=nPts),
+            rng.uniform(lbnd_f[1], ubnd_f[1], size=nPts),
+        ])
+        # include the bounds of the domain, which are valid
+        indata[:, 0] = lbnd_f
+        indata[:, 1] = ubnd_f
+        # and some points outside the domain, which are not
+        indata[0, 2] = lbnd_f[0] - 0.01
+        indata[1, 3] = ubnd_f[1] + 0.01
+        indata[0, 4] = np.nan
+        isBad = np.zeros(nPts, dtype=bool)
+        isBad[2:5] = True
+
+        x1, x2 = normalize(indata, lbnd_f, ubnd_f)
+        desOutdata = np.array([chebval2d(x1, x2, c1), chebval2d(x1, x2, c2)])
+        self.assertEqual(getPolyEvaluatorIds(chebyMap), [0, 0])
+        outdata = chebyMap.applyForward(indata)
+        # there is no inverse, so only the forward evaluator is built
+        evaluatorIds = getPolyEvaluatorIds(chebyMap)
+        self.assertNotEqual(evaluatorIds[0], 0)
+        self.assertEqual(evaluatorIds[1], 0)
+        # tolerance is rounding error relative to the sum of |coeff| of 36 terms
+        npt.assert_allclose(outdata[:, ~isBad], desOutdata[:, ~isBad], atol=1e-12)
+        self.assertTrue(np.all(np.isnan(outdata[:, isBad])))
+        astOutdata = applyWithAst(chebyMap, indata, True)
+        npt.assert_allclose(outdata[:, ~isBad], astOutdata[:, ~isBad], atol=1e-12)
+        self.assertTrue(np.all(np.isnan(astOutdata[:, 2:4])))
+
+        npt.assert_allclose(chebyMap.inverted().applyInverse(indata), outdata, equal_nan=True)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -109,6 +109,38 @@ class TestCmpMap(MappingTestCase):
         self.checkMappingPersistence(parmap2, indata)
         self.checkMappingPersistence(parmap3, indata)
 
+    def test_CmpMapNested(self):
+        """Test the type and series flag of components of nested compound maps
+        """
+        parmap = self.shiftmap.under(self.zoommap)
+        sermap = self.zoommap.then(self.shiftmap)
+        nested = parmap.then(sermap.under(sermap)).under(sermap)
+        self.assertIsInstance(nested, ast.ParallelMap)
+        self.assertFalse(nested.series)
+
+        left, right = nested[0], nested[1]
+        self.assertIsInstance(left, ast.SeriesMap)
+        self.assertTrue(left.series)
+        self.assertIsInstance(right, ast.SeriesMap)
+        self.assertEqual(right, sermap)
+        self.assertIsInstance(left[0], ast.ParallelMap)
+        self.assertFalse(left[0].series)
+        self.assertEqual(left[0], parmap)
+        self.assertIsInstance(left[1], ast.ParallelMap)
+        self.assertIsInstance(left[1][0], ast.SeriesMap)
+        self.assertIsInstance(left[1][1], ast.SeriesMap)
+        self.assertIsInstance(left[1][0][0], ast.ZoomMap)
+
+        # copies and persisted objects keep their type and series flag
+        for obj in (nested, left, left[0]):
+            cp = obj.copy()
+            self.assertIs(type(cp), type(obj))
+            self.assertEqual(cp.series, obj.series)
+            self.assertEqual(cp.className, obj.className)
+            fromStr = ast.Object.fromString(obj.show())
+            self.assertIs(type(fromStr), type(obj))
+            self.assertEqual(fromStr.series, obj.series)
+
     def test_SeriesMapMatrixShiftSimplify(self):
         """Test that a non-square matrix map followed by a shift map can be
         simplified.
@@ -0,0 +1,94 @@
+import unittest
+
+import numpy as np
+from numpy.testing import assert_allclose, assert_equal
+
+import astshim as ast
+from astshim.test import MappingTestCase, makeTwoWayPolyMap
+
+
+class TestCompiledMapping(MappingTestCase):
+
+    def makeChain(self):
+        """Make a series compound mapping that does not simplify to a single mapping
+
+        The component mappings have an Ident, which prevents simplification.
+        """
+        shiftMap = ast.ShiftMap([1.5, -0.5], "Ident=shift")
+        zoomMap = ast.ZoomMap(2, 0.25, "Ident=zoom")
+        invZoomMap = ast.ZoomMap(2, 2.0, "Ident=invzoom").inverted()
+        polyMap = makeTwoWayPolyMap(2, 2)
+        polyMap.ident = "poly"
+        return shiftMap.then(zoomMap).then(polyMap.then(invZoomMap))
+
+    def test_basics(self):
+        chain = self.makeChain()
+        compiled = chain.compiled()
+        self.assertIsInstance(compiled, ast.CompiledMapping)
+        self.assertEqual(compiled.nIn, 2)
+        self.assertEqual(compiled.nOut, 2)
+        self.assertEqual(compiled.nStages, 4)
+
+        unitCompiled = ast.CompiledMapping(ast.UnitMap(3))
+        self.assertEqual(unitCompiled.nIn, 3)
+        self.assertEqual(unitCompiled.nStages, 0)
+        fromArr = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, np.nan]])
+        assert_equal(unitCompiled.applyForward(fromArr), fromArr)
+
+    def test_matchesMapping(self):
+        """Check that CompiledMapping gives the same results as Mapping
+        for a variety of array sizes, including more than one tile
+        """
+        for chain in (self.makeChain(), self.makeChain().inverted()):
+            compiled = chain.compiled()
+            for nPts in (0, 1, 4095, 4096, 10000):
+                fromArr = np.random.uniform(-1, 1, size=(2, nPts))
+                toArr = compiled.applyForward(fromArr)
+                assert_allclose(toArr, chain.applyForward(fromArr))
+                assert_allclose(compiled.applyInverse(toArr), chain.applyInverse(toArr))
+
+                toArr2 = np.zeros((2, nPts))
+                compiled.applyForward(fromArr, toArr2)
+                assert_equal(toArr2, toArr)
+
+        with self.assertRaises(Exception):
+            compiled.applyForward(np.zeros((3, 5)))
+
+    def test_nan(self):
+        """Check that nan input gives nan output, including AST__BAD from an intermediate stage
+        """
+        mathMap = ast.MathMap(1, 1, ["y = qif(x < 0, <bad>, x)"], ["x = y"], "Ident=math")
+        chain = mathMap.then(ast.ZoomMap(1, 3.0, "Ident=zoom"))
+        compiled = chain.compiled()
+        fromArr = np.array([np.linspace(-1, 1, 101)])
+        fromArr[0, 80] = np.nan
+        toArr = compiled.applyForward(fromArr)
+        isBad = (fromArr[0] < 0) | np.isnan(fromArr[0])
+        self.assertTrue(np.all(np.isnan(toArr[0, isBad])))
+        assert_allclose(toArr[0, ~isBad], fromArr[0, ~isBad] * 3.0)
+
+    def test_copiesAreIndependent(self):
+        """Changing the original mapping does not affect the compiled mapping
+        """
+        fromArr = np.array([[1.0, 2.0], [3.0, 4.0]])
+
+        # a ZoomMap, which is evaluated without AST
+        zoomMap = ast.ZoomMap(2, 1.3, "Invert=1")
+        compiled = zoomMap.compiled()
+        zoomMap.clear("Invert")
+        self.assertFalse(zoomMap.isInverted)
+        assert_allclose(zoomMap.applyForward(fromArr), fromArr * 1.3)
+        assert_allclose(compiled.applyForward(fromArr), fromArr / 1.3)
+
+        # a compound mapping, which has a stage evaluated by AST
+        shift = [0.5, -1.5]
+        seriesMap = ast.SeriesMap(ast.ShiftMap(shift), ast.ZoomMap(2, 1.3), "Invert=1")
+        compiled = seriesMap.compiled()
+        desToArr = seriesMap.applyForward(fromArr)
+        seriesMap.clear("Invert")
+        assert_allclose(seriesMap.applyForward(fromArr), (fromArr.T + shift).T * 1.3)
+        assert_allclose(compiled.applyForward(fromArr), desToArr)
+
+
+if __name__ == "__main__":
+    unittest.main()
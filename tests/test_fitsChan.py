@@ -171,6 +171,89 @@ class TestFitsChan(ObjectTestCase):
         del fc2
         os.remove(path)
 
+    def test_FitsChanMmapStream(self):
+        """Test reading a FitsChan from a MmapStream
+        """
+        path = os.path.join(self.dataDir, "test_fitsChanMmapStream.fits")
+        fc1 = ast.FitsChan(ast.FileStream(path, True))
+        fc1.putCards("".join(self.cards))
+        del fc1
+
+        fc2 = ast.FitsChan(ast.MmapStream(path))
+        self.assertEqual(fc2.nCard, len(self.cards))
+        self.assertEqual(fc2.getAllCardNames(),
+                         [card.split(" ", 1)[0] for card in self.cards])
+        del fc2
+        os.remove(path)
+
+    def test_FitsChanGetAllCards(self):
+        fc = ast.FitsChan(ast.StringStream())
+        fc.putCards("".join(self.cards))
+        fc.setCard(3)
+        allCards = fc.getAllCards()
+        self.assertEqual(fc.getCard(), 3)
+
+        nCards = len(self.cards)
+        self.assertEqual(allCards.names, fc.getAllCardNames())
+        self.assertEqual(allCards.cards, list(fc))
+        fc.setCard(3)
+        self.assertEqual(fc.getAllCardText(), allCards.cards)
+        self.assertEqual(fc.getCard(), 3)
+        self.assertEqual(str(fc), "\n".join(allCards.cards))
+        self.assertEqual(len(allCards.types), nCards)
+        self.assertEqual(len(allCards.values), nCards)
+        self.assertEqual(len(allCards.comments), nCards)
+        for i in range(nCards):
+            fc.setCard(i + 1)
+            self.assertEqual(allCards.types[i], fc.getCardType())
+            self.assertEqual(allCards.comments[i], fc.getCardComm())
+            if allCards.types[i] in (ast.CardType.COMMENT, ast.CardType.UNDEF):
+                self.assertEqual(allCards.values[i], "")
+            else:
+                self.assertEqual(allCards.values[i], fc.getFitsS().value)
+
+        self.assertEqual(allCards.types[2], ast.CardType.STRING)
+        self.assertEqual(allCards.values[2], fc.getFitsS("CTYPE1").value)
+        self.assertEqual(allCards.types[0], ast.CardType.INT)
+        self.assertEqual(int(allCards.values[0]), 200)
+        self.assertEqual(allCards.types[11], ast.CardType.UNDEF)
+        self.assertEqual(allCards.names[12], "BOOL")
+        self.assertEqual(allCards.comments[12], "Repeat")
+
+        emptyCards = ast.FitsChan(ast.StringStream()).getAllCards()
+        self.assertEqual(emptyCards.names, [])
+        self.assertEqual(emptyCards.cards, [])
+        self.assertEqual(ast.FitsChan(ast.StringStream()).getAllCardText(), [])
+
+    def test_FitsChanPutHeader(self):
+        """Test FitsChan.putHeader with a padded FITS header block
+        """
+        header = "".join(self.cards) + pad("END")
+        header += " " * (2880 - len(header) % 2880)
+        fc = ast.FitsChan(ast.StringStream())
+        fc.putFits(pad("COMMENT to be replaced"), False)
+        nCards = fc.putHeader(header.encode())
+        self.assertEqual(nCards, len(self.cards))
+        self.assertEqual(fc.nCard, len(self.cards))
+        self.assertEqual(fc.getCard(), 1)
+
+        fc2 = ast.FitsChan(ast.StringStream())
+        fc2.putCards("".join(self.cards))
+        self.assertEqual(fc.getAllCardNames(), fc2.getAllCardNames())
+        self.assertEqual(fc.getFitsS("CTYPE1").value, fc2.getFitsS("CTYPE1").value)
+        self.assertEqual(fc.getFitsF("CDELT2").value, fc2.getFitsF("CDELT2").value)
+
+        # numpy arrays of bytes are accepted without copying
+        fc3 = ast.FitsChan(ast.StringStream())
+        self.assertEqual(fc3.putHeader(np.frombuffer(header.encode(), dtype=np.uint8)), len(self.cards))
+
+        # a header with no END card is read in full
+        self.assertEqual(fc3.putHeader("".join(self.cards[0:3]).encode()), 3)
+        self.assertEqual(fc3.nCard, 3)
+
+        with self.assertRaises(ValueError):
+            fc3.putHeader(header[0:-1].encode())
+
     def test_FitsChanWriteOnDelete(self):
         """Test that a FitsChan writes cards when it is deleted
         """
@@ -0,0 +1,74 @@
+import unittest
+
+import astshim as ast
+from astshim.test import ObjectTestCase
+
+
+def pad(card):
+    """Pad a string with spaces to length 80 characters"""
+    return "%-80s" % (card,)
+
+
+def makeFrameSet(crval1, crpix1):
+    """Make a TAN WCS FrameSet from FITS cards"""
+    cards = [pad(card) for card in (
+        "NAXIS1  =                  200",
+        "NAXIS2  =                  200",
+        "CTYPE1  = 'RA---TAN'",
+        "CTYPE2  = 'DEC--TAN'",
+        "CRPIX1  = %20.10f" % (crpix1,),
+        "CRPIX2  =                  100",
+        "CDELT1  =                0.001",
+        "CDELT2  =                0.001",
+        "CRVAL1  = %20.10f" % (crval1,),
+        "CRVAL2  =                   10",
+    )]
+    fc = ast.FitsChan(ast.StringStream("".join(cards)))
+    return fc.read()
+
+
+def writeHeader(frameSet, options):
+    """Write a FrameSet as a FITS header with a new FitsChan"""
+    fc = ast.FitsChan(ast.StringStream(), options)
+    fc.write(frameSet)
+    return "".join(pad(card) for card in fc)
+
+
+class TestFitsWcsWriter(ObjectTestCase):
+
+    def test_FitsWcsWriter(self):
+        templ = makeFrameSet(crval1=5, crpix1=100)
+        writer = ast.FitsWcsWriter(templ, options="CDMatrix=1")
+        self.assertEqual(writer.encoding, "FITS-WCS")
+
+        for crval1, crpix1 in ((5, 100), (12.5, 98.25), (359.5, -1000.75)):
+            frameSet = makeFrameSet(crval1=crval1, crpix1=crpix1)
+            header = writer.write(frameSet)
+            self.assertEqual(len(header) % 80, 0)
+            self.assertEqual(header, writeHeader(frameSet, "Encoding=FITS-WCS, CDMatrix=1"))
+
+            fc = ast.FitsChan(ast.StringStream())
+            fc.putCards(header)
+            self.assertAlmostEqual(fc.getFitsF("CRVAL1").value, crval1)
+            self.assertAlmostEqual(fc.getFitsF("CRPIX1").value, crpix1)
+
+    def test_FitsWcsWriterEncodings(self):
+        templ = makeFrameSet(crval1=5, crpix1=100)
+        writer = ast.FitsWcsWriter(templ, encodings=["DSS", "FITS-WCS", "NATIVE"])
+        self.assertEqual(writer.encoding, "FITS-WCS")
+
+        writer = ast.FitsWcsWriter(templ, encodings=["NATIVE"])
+        self.assertEqual(writer.encoding, "NATIVE")
+        frameSet = makeFrameSet(crval1=12.5, crpix1=98.25)
+        header = writer.write(frameSet)
+        self.assertEqual(header, writeHeader(frameSet, "Encoding=NATIVE"))
+
+        with self.assertRaises(ValueError):
+            ast.FitsWcsWriter(templ, encodings=[])
+        for options in ("Encoding=NATIVE", "CDMatrix=1, encoding=FITS-WCS"):
+            with self.assertRaises(ValueError):
+                ast.FitsWcsWriter(templ, options=options)
+
+
+if __name__ == "__main__":
+    unittest.main()
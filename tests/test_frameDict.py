@@ -68,6 +68,27 @@ class TestFrameDict(MappingTestCase):
         frameDict2 = makeFrameDict(frameSet)
         self.assertEqual(frameDict2.getRefCount(), 1)
 
+    def test_FrameDictManyFrames(self):
+        """Test a FrameDict with many frames, some with no domain
+        """
+        frameSet = ast.FrameSet(self.frame1)
+        frameDict = ast.FrameDict(self.frame1)
+        for i in range(2, 31):
+            domain = "" if i % 5 == 0 else "FRAME%d" % (i,)
+            frame = ast.Frame(2, "Domain=%s" % (domain,)) if domain else ast.Frame(2)
+            frameSet.addFrame(i - 1, self.zoomMap, frame)
+            frameDict.addFrame(i - 1, self.zoomMap, frame)
+        frameDict2 = ast.FrameDict(frameSet)
+        for fd in (frameDict, frameDict2):
+            self.assertEqual(fd.nFrame, 30)
+            self.assertEqual(len(fd.getAllDomains()), 30 - 6)
+            self.assertEqual(fd.getIndex("FRAME29"), 29)
+            self.assertFalse(fd.hasDomain("FRAME10"))
+            for index in range(1, fd.nFrame + 1):
+                domain = fd.getFrame(index).domain
+                if domain:
+                    self.assertEqual(fd.getIndex(domain), index)
+
     def test_FrameDictAddFrame(self):
         frameDict = ast.FrameDict(self.frame1)
         self.assertEqual(self.frame1.getNObject(), self.initialNumFrames + 1)
@@ -98,6 +119,37 @@ class TestFrameDict(MappingTestCase):
         self.assertEqual(frameDict.getFrame("FRAME1").ident, "f1")
         self.checkDict(frameDict)
 
+        # a mapping with the wrong number of axes is rejected by AST,
+        # and that also leaves the FrameDict unchanged
+        frame3 = ast.Frame(3, "Domain=FRAME3")
+        with self.assertRaises(RuntimeError):
+            frameDict.addFrame(1, self.zoomMap, frame3)
+        self.assertEqual(frameDict.nFrame, 2)
+        self.assertEqual(frameDict.current, 2)
+        self.assertEqual(frameDict.getAllDomains(), {"FRAME1", "FRAME2"})
+        self.checkDict(frameDict)
+
+    def test_FrameDictAddFrameSet(self):
+        """Test merging a FrameSet into a FrameDict with addFrame
+        """
+        frameDict = ast.FrameDict(self.frame1)
+        frame3 = ast.Frame(2, "Domain=FRAME3, Ident=f3")
+        frameSet = ast.FrameSet(self.frame2, self.zoomMap, frame3)
+        frameDict.addFrame(1, self.zoomMap, frameSet)
+        self.assertEqual(frameDict.nFrame, 3)
+        self.assertEqual(frameDict.getAllDomains(), {"FRAME1", "FRAME2", "FRAME3"})
+        self.assertEqual(frameDict.getIndex("FRAME2"), 2)
+        self.assertEqual(frameDict.getIndex("FRAME3"), 3)
+        self.checkDict(frameDict)
+
+        # merging a FrameSet with any duplicate domain fails and leaves the FrameDict unchanged
+        frameSet2 = ast.FrameSet(ast.Frame(2, "Domain=FRAME4"), self.zoomMap, ast.Frame(2, "Domain=FRAME2"))
+        with self.assertRaises(ValueError):
+            frameDict.addFrame(1, self.zoomMap, frameSet2)
+        self.assertEqual(frameDict.nFrame, 3)
+        self.assertEqual(frameDict.getAllDomains(), {"FRAME1", "FRAME2", "FRAME3"})
+        self.checkDict(frameDict)
+
     def test_FrameDictFrameMappingFrameConstructor(self):
         frameDict = ast.FrameDict(self.frame1, self.zoomMap, self.frame2)
         self.assertEqual(frameDict.nFrame, 2)
@@ -171,6 +223,45 @@ class TestFrameDict(MappingTestCase):
         self.assertEqual(frameDict.getAllDomains(), {"FRAME1", "FRAME2"})
         self.checkDict(frameDict)
 
+    def test_FrameDictGetViews(self):
+        frameDict = ast.FrameDict(self.frame1, self.zoomMap, self.frame2)
+        frameDict.setMappingCacheEnabled(True)
+        indata = np.array([[1.1, 2.1, 3.1], [1.2, 2.2, 3.2]])
+
+        for index, domain in ((1, "FRAME1"), (2, "frame2")):
+            frameViewList = (frameDict.getFrameView(index), frameDict.getFrameView(domain))
+            for frameView in frameViewList:
+                self.assertIsInstance(frameView, ast.Frame)
+                self.assertEqual(frameView.domain, domain.upper())
+            self.assertTrue(frameViewList[0].same(frameViewList[1]))
+
+        mappingViewList = (  # all should be the same
+            frameDict.getMappingView(),
+            frameDict.getMappingView("FRAME1", "FRAME2"),
+            frameDict.getMappingView(frameDict.BASE, "frame2"),
+            frameDict.getMappingView("frame1", frameDict.CURRENT),
+        )
+        for mappingView in mappingViewList:
+            self.assertEqual(mappingView.ident, "zoomMap")
+            self.assertTrue(mappingView.same(mappingViewList[0]))
+            assert_allclose(mappingView.applyForward(indata), indata * self.zoom)
+        assert_allclose(frameDict.getMappingView("FRAME2", "FRAME1").applyForward(indata),
+                        indata / self.zoom)
+
+        # changing a view does not change the FrameDict
+        mappingViewList[1].ident = "newIdent"
+        self.assertEqual(frameDict.getMapping().ident, "zoomMap")
+        self.assertEqual(mappingViewList[2].ident, "zoomMap")
+
+        for index in (3, "BadFrame", ""):
+            with self.assertRaises((IndexError, RuntimeError)):
+                frameDict.getFrameView(index)
+            with self.assertRaises((IndexError, RuntimeError)):
+                frameDict.getMappingView(index, "FRAME1")
+            with self.assertRaises((IndexError, RuntimeError)):
+                frameDict.getMappingView("FRAME1", index)
+        self.checkDict(frameDict)
+
     def test_FrameDictRemoveFrame(self):
         frameDict = ast.FrameDict(self.frame1, self.zoomMap, self.frame2)
         zoomMap2 = ast.ZoomMap(2, 1.3, "Ident=zoomMap2")
@@ -377,6 +468,9 @@ class TestFrameDict(MappingTestCase):
         frameDict.setDomain("NEWFRAME2")
         self.assertEqual(frameDict.getFrame(frameDict.CURRENT).domain, "NEWFRAME2")
         self.assertEqual(frameDict.getAllDomains(), {"NEWFRAME1", "NEWFRAME2"})
+        frameDict.setDomain("newFrame2")
+        self.assertEqual(frameDict.getAllDomains(), {"NEWFRAME1", "NEWFRAME2"})
+        self.assertTrue(frameDict.hasDomain("newFrame2"))
 
         # Make sure setDomain cannot be used to rename a domain to a duplicate
         # and that this leaves the frameDict unchanged
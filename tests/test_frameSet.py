@@ -93,6 +93,27 @@ class TestFrameSet(MappingTestCase):
         self.assertEqual(frameSet.getFrame(ast.FrameSet.BASE).ident, "base")
         self.assertEqual(frame.ident, "base")
 
+    def test_FrameSetGetFrameView(self):
+        frameSet = ast.FrameSet(ast.Frame(2, "Ident=base"))
+        frameSet.addFrame(1, ast.UnitMap(2), ast.Frame(2, "Domain=CURRENT, Ident=current"))
+
+        # the view shares the frame in the FrameSet, unlike getFrame
+        frameView = frameSet.getFrameView(ast.FrameSet.CURRENT)
+        self.assertEqual(frameView.ident, "current")
+        self.assertGreater(frameView.getRefCount(), 1)
+        self.assertEqual(frameSet.getFrame(ast.FrameSet.CURRENT).getRefCount(), 1)
+
+        # changes to the frame in the FrameSet are seen by the view
+        frameSet.domain = "NEWDOMAIN"
+        self.assertEqual(frameView.domain, "NEWDOMAIN")
+
+        # changes to the view copy the frame first, so do not affect the FrameSet
+        frameView.ident = "modifiedCurrent"
+        self.assertEqual(frameView.getRefCount(), 1)
+        self.assertEqual(frameSet.getFrame(ast.FrameSet.CURRENT).ident, "current")
+        frameSet.domain = "NEWERDOMAIN"
+        self.assertEqual(frameView.domain, "NEWDOMAIN")
+
     def test_FrameSetGetMapping(self):
         frame = ast.Frame(2, "Ident=base")
         frameSet = ast.FrameSet(frame)
@@ -114,6 +135,105 @@ class TestFrameSet(MappingTestCase):
         self.assertEqual(mappingDeep.getRefCount(), 1)
         self.assertEqual(mapping.getNObject(), initialNumUnitMap + 2)
 
+    def test_FrameSetGetMappingCache(self):
+        frameSet = ast.FrameSet(ast.Frame(2, "Ident=base"))
+        zoom = 0.5
+        frameSet.addFrame(1, ast.ZoomMap(2, zoom, "Ident=zoom"), ast.Frame(2, "Ident=current"))
+        indata = np.array([
+            [0.0, 0.1, -1.5],
+            [5.1, 0.0, 3.1],
+        ])
+        self.assertFalse(frameSet.getMappingCacheEnabled())
+        frameSet.setMappingCacheEnabled(True)
+        self.assertTrue(frameSet.getMappingCacheEnabled())
+
+        # repeated requests return equal but independent copies
+        mapping1 = frameSet.getMapping()
+        mapping2 = frameSet.getMapping(1, 2)
+        self.assertEqual(mapping1, mapping2)
+        mapping1.ident = "modifiedMapping"
+        self.assertEqual(frameSet.getMapping().ident, "zoom")
+        self.assertEqual(mapping2.ident, "zoom")
+        assert_allclose(frameSet.getMapping().applyForward(indata), indata * zoom)
+
+        # each kind of change to the FrameSet is seen by getMapping
+        shift = (0.5, -1.5)
+        frameSet.remapFrame(1, ast.ShiftMap(shift))
+        predictedOut = (indata.T - shift).T * zoom
+        assert_allclose(frameSet.getMapping().applyForward(indata), predictedOut)
+        assert_allclose(frameSet.getMapping(1, 2).applyForward(indata), predictedOut)
+
+        zoom2 = 3.0
+        frameSet.addFrame(2, ast.ZoomMap(2, zoom2), ast.Frame(2, "Ident=third"))
+        self.assertEqual(frameSet.current, 3)
+        assert_allclose(frameSet.getMapping().applyForward(indata), predictedOut * zoom2)
+
+        frameSet.current = 2
+        assert_allclose(frameSet.getMapping().applyForward(indata), predictedOut)
+
+        frameSet.base = 3
+        assert_allclose(frameSet.getMapping().applyForward(indata), indata / zoom2)
+
+        frameSet.removeFrame(3)
+        self.assertEqual(frameSet.base, 1)
+        assert_allclose(frameSet.getMapping().applyForward(indata), predictedOut)
+
+        # the cache holds at most MAPPING_CACHE_SIZE mappings; older ones are found again
+        for i in range(ast.FrameSet.MAPPING_CACHE_SIZE):
+            frameSet.addFrame(ast.FrameSet.CURRENT, ast.ZoomMap(2, 2.0), ast.Frame(2))
+        for i in range(1, frameSet.nFrame + 1):
+            assert_allclose(frameSet.getMapping(1, i).applyForward(indata),
+                            frameSet.getMapping(i, 1).applyInverse(indata))
+        assert_allclose(frameSet.getMapping().applyForward(indata),
+                        predictedOut * 2.0**ast.FrameSet.MAPPING_CACHE_SIZE)
+
+        frameSet.setMappingCacheEnabled(False)
+        self.assertFalse(frameSet.getMappingCacheEnabled())
+        assert_allclose(frameSet.getMapping().applyForward(indata),
+                        predictedOut * 2.0**ast.FrameSet.MAPPING_CACHE_SIZE)
+
+    def test_FrameSetGetMappingView(self):
+        frameSet = ast.FrameSet(ast.Frame(2, "Ident=base"))
+        zoom = 0.5
+        frameSet.addFrame(1, ast.ZoomMap(2, zoom, "Ident=zoom"), ast.Frame(2, "Ident=current"))
+        frameSet.setMappingCacheEnabled(True)
+        indata = np.array([
+            [0.0, 0.1, -1.5],
+            [5.1, 0.0, 3.1],
+        ])
+
+        # views of a cached mapping share it, unlike getMapping
+        mappingView1 = frameSet.getMappingView()
+        mappingView2 = frameSet.getMappingView(1, 2)
+        self.assertTrue(mappingView1.same(mappingView2))
+        self.assertGreater(mappingView1.getRefCount(), 2)
+        self.assertEqual(frameSet.getMapping().getRefCount(), 1)
+        self.assertEqual(mappingView1.ident, "zoom")
+        assert_allclose(mappingView1.applyForward(indata), indata * zoom)
+
+        # changes to a view copy the mapping first, so do not affect the FrameSet or other views
+        mappingView1.ident = "modifiedMapping"
+        self.assertEqual(mappingView1.getRefCount(), 1)
+        self.assertFalse(mappingView1.same(mappingView2))
+        self.assertEqual(mappingView2.ident, "zoom")
+        self.assertEqual(frameSet.getMappingView().ident, "zoom")
+
+        # a view is a snapshot: later changes to the FrameSet are not seen by it,
+        # but are seen by new views
+        shift = (0.5, -1.5)
+        frameSet.remapFrame(1, ast.ShiftMap(shift))
+        assert_allclose(mappingView2.applyForward(indata), indata * zoom)
+        assert_allclose(frameSet.getMappingView().applyForward(indata), (indata.T - shift).T * zoom)
+
+        # the same holds with the cache disabled
+        frameSet.setMappingCacheEnabled(False)
+        mappingView = frameSet.getMappingView()
+        assert_allclose(mappingView.applyForward(indata), (indata.T - shift).T * zoom)
+        frameSet.remapFrame(1, ast.ShiftMap(shift))
+        assert_allclose(mappingView.applyForward(indata), (indata.T - shift).T * zoom)
+        assert_allclose(frameSet.getMappingView().applyForward(indata),
+                        (indata.T - 2 * np.array(shift)).T * zoom)
+
     def test_FrameSetRemoveFrame(self):
         frame = ast.Frame(2, "Ident=base")
         initialNumFrames = frame.getNObject()  # may be >1 when run using pytest
@@ -240,6 +360,35 @@ class TestFrameSet(MappingTestCase):
         self.assertAlmostEqual(frameSet.applyForward([x, y, z]), [x, y])
         self.assertAlmostEqual(frameSet.applyInverse([x, y]), [x, y, z])
 
+    def test_FrameSetNInNOut(self):
+        """Test that nIn and nOut track changes to the base and current frame
+        """
+        frame1 = ast.Frame(3)
+        permMap = ast.PermMap([1, 2, -1], [1, 2], [0.123])
+        frame2 = ast.Frame(2)
+        frameSet = ast.FrameSet(frame1, permMap, frame2)
+        self.assertEqual(frameSet.nIn, 3)
+        self.assertEqual(frameSet.nOut, 2)
+
+        frameSet.addFrame(2, ast.PermMap([1, -1], [1], [0.0]), ast.Frame(1))
+        self.assertEqual(frameSet.nIn, 3)
+        self.assertEqual(frameSet.nOut, 1)
+
+        frameSet.base = 2
+        self.assertEqual(frameSet.nIn, 2)
+        frameSet.current = 1
+        self.assertEqual(frameSet.nOut, 3)
+        self.assertFalse(frameSet.isInverted)
+
+        invFrameSet = frameSet.inverted()
+        self.assertEqual(invFrameSet.nIn, 3)
+        self.assertEqual(invFrameSet.nOut, 2)
+        self.assertTrue(invFrameSet.isInverted)
+
+        frameSet.removeFrame(1)
+        self.assertEqual(frameSet.nIn, 2)
+        self.assertEqual(frameSet.nOut, 1)
+
 
 if __name__ == "__main__":
     unittest.main()
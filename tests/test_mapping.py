@@ -1,7 +1,8 @@
+import threading
 import unittest
 
 import numpy as np
-from numpy.testing import assert_allclose
+from numpy.testing import assert_allclose, assert_array_equal
 
 import astshim as ast
 from astshim.test import MappingTestCase, makeTwoWayPolyMap
@@ -157,6 +158,123 @@ class TestMapping(MappingTestCase):
         out_points2 = mapping.applyInverse([])
         self.assertEqual(len(out_points2), 0)
 
+    def test_badToNan(self):
+        """Test that AST__BAD is replaced with nan unless badToNan is false
+        """
+        nPts = 10000  # enough to use more than one tile of points
+        mathMap = ast.MathMap(1, 1, ["y = qif(x < 0, <bad>, x)"], ["x = qif(y < 0, <bad>, y)"])
+        indata = np.array([np.linspace(-1, 1, nPts)])
+        isNeg = indata[0] < 0
+        for applyFunc in (mathMap.applyForward, mathMap.applyInverse):
+            outdata = applyFunc(indata)
+            self.assertTrue(np.all(np.isnan(outdata[0, isNeg])))
+            assert_allclose(outdata[0, ~isNeg], indata[0, ~isNeg])
+
+            rawOutdata = applyFunc(indata, badToNan=False)
+            self.assertFalse(np.any(np.isnan(rawOutdata)))
+            self.assertTrue(np.all(rawOutdata[0, isNeg] == -np.finfo(float).max))
+            assert_allclose(rawOutdata[0, ~isNeg], indata[0, ~isNeg])
+
+    def test_nanInput(self):
+        """Test that nan input gives nan output and that isValid flags it
+        """
+        nPts = 10000  # enough to use more than one tile of points
+        zoomMap = ast.ZoomMap(2, 3.0)
+        indata = np.array([np.linspace(-1, 1, nPts), np.linspace(0, 5, nPts)])
+        indata[0, [5, 6000, 9999]] = np.nan
+        indata[1, 7000] = np.nan
+        inIsNan = np.isnan(indata)
+        for applyFunc in (zoomMap.applyForward, zoomMap.applyInverse):
+            outdata = applyFunc(indata)
+            assert_array_equal(np.isnan(outdata), inIsNan)
+
+            isValid = np.zeros(nPts, dtype=bool)
+            outdata2 = applyFunc(indata, isValid=isValid)
+            assert_allclose(outdata2, outdata, equal_nan=True)
+            assert_array_equal(isValid, ~np.any(inIsNan, axis=0))
+
+            with self.assertRaises(Exception):
+                applyFunc(indata, isValid=np.zeros(nPts - 1, dtype=bool))
+
+    def test_strided(self):
+        """Test applyForwardStrided and applyInverseStrided on interleaved data
+        """
+        nPts = 10000  # enough to use more than one tile of points
+        polyMap = makeTwoWayPolyMap(2, 2)
+        # points stored as (x, y) pairs, as in an array of structs, with one extra padding column
+        indata = np.zeros((nPts, 3))
+        indata[:, 0] = np.linspace(-1, 1, nPts)
+        indata[:, 1] = np.linspace(0, 0.5, nPts)
+        indata[17, 1] = np.nan
+        inview = indata[:, 0:2].T
+        self.assertFalse(inview.flags.c_contiguous)
+        for applyFunc, applyStridedFunc in (
+            (polyMap.applyForward, polyMap.applyForwardStrided),
+            (polyMap.applyInverse, polyMap.applyInverseStrided),
+        ):
+            desOutdata = applyFunc(np.ascontiguousarray(inview))
+            outdata = np.full((nPts, 3), 5.0)
+            outview = outdata[:, 1:3].T
+            applyStridedFunc(inview, outview)
+            assert_allclose(outview, desOutdata, equal_nan=True)
+            self.assertTrue(np.all(np.isnan(outview[:, 17])))
+            # the padding column is untouched
+            self.assertTrue(np.all(outdata[:, 0] == 5.0))
+
+            with self.assertRaises(Exception):
+                applyStridedFunc(inview, outdata[:, 1:2].T)
+
+    def test_preallocated(self):
+        """Test the overloads of applyForward, applyInverse, tranGridForward and tranGridInverse
+        that write into a pre-allocated array
+        """
+        polyMap = makeTwoWayPolyMap(2, 3)
+        indata = np.array([np.linspace(-1, 1, 100), np.linspace(0, 0.5, 100)])
+        outdata = np.zeros((3, 100))
+        polyMap.applyForward(indata, outdata)
+        assert_allclose(outdata, polyMap.applyForward(indata))
+        indata2 = np.zeros((2, 100))
+        polyMap.applyInverse(outdata, indata2)
+        assert_allclose(indata2, polyMap.applyInverse(outdata))
+        isValid = np.zeros(100, dtype=bool)
+        polyMap.applyForward(indata, outdata, isValid)
+        self.assertTrue(np.all(isValid))
+
+        with self.assertRaises(Exception):
+            polyMap.applyForward(indata, np.zeros((2, 100)))
+
+        lbnd = [0, 1]
+        ubnd = [4, 2]
+        nPoints = 10
+        gridOut = np.zeros((3, nPoints))
+        polyMap.tranGridForward(lbnd, ubnd, 0, 100, gridOut)
+        assert_allclose(gridOut, polyMap.tranGridForward(lbnd, ubnd, 0, 100, nPoints))
+        gridIn = np.zeros((2, nPoints))
+        polyMap.tranGridInverse([0, 1, 0], [4, 2, 0], 0, 100, gridIn)
+        assert_allclose(gridIn, polyMap.tranGridInverse([0, 1, 0], [4, 2, 0], 0, 100, nPoints))
+
+    def test_threads(self):
+        """Test that Python threads can transform points concurrently,
+        each using its own Mapping
+        """
+        nThreads = 4
+        indata = np.array([np.linspace(-1, 1, 100000), np.linspace(0, 0.5, 100000)])
+        desOutdata = makeTwoWayPolyMap(2, 3).applyForward(indata)
+        outdataList = [np.zeros((3, indata.shape[1])) for i in range(nThreads)]
+
+        def transform(outdata):
+            polyMap = makeTwoWayPolyMap(2, 3)
+            for i in range(5):
+                polyMap.applyForward(indata, outdata)
+
+        threads = [threading.Thread(target=transform, args=(outdata,)) for outdata in outdataList]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for outdata in outdataList:
+            assert_allclose(outdata, desOutdata)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,97 @@
+import unittest
+
+import numpy as np
+from numpy.testing import assert_allclose, assert_equal
+
+import astshim as ast
+from astshim.detail.testUtils import getPolyEvaluatorIds
+from astshim.test import MappingTestCase, makeTwoWayPolyMap
+
+
+class TestMappingPool(MappingTestCase):
+
+    def test_basics(self):
+        zoommap = ast.ZoomMap(2, 1.3)
+        pool = ast.MappingPool(zoommap, 3)
+        self.assertEqual(pool.nIn, 2)
+        self.assertEqual(pool.nOut, 2)
+        self.assertEqual(pool.nThreads, 3)
+
+        defaultPool = ast.MappingPool(zoommap)
+        self.assertGreaterEqual(defaultPool.nThreads, 1)
+
+        with self.assertRaises(ValueError):
+            ast.MappingPool(zoommap, -1)
+
+    def test_matchesMapping(self):
+        """Check that MappingPool gives the same results as Mapping
+        for a variety of array sizes, including ones that are not
+        evenly divisible among the threads
+        """
+        polyMap = makeTwoWayPolyMap(2, 2)
+        pool = ast.MappingPool(polyMap, 4)
+        nPtsPerThread = ast.MappingPool.MIN_POINTS_PER_THREAD
+        for nPts in (0, 1, nPtsPerThread - 1, nPtsPerThread * 3 + 7, nPtsPerThread * 10 + 1):
+            fromArr = np.random.uniform(-1, 1, size=(2, nPts))
+            desToArr = polyMap.applyForward(fromArr)
+            toArr = pool.applyForward(fromArr)
+            assert_equal(toArr, desToArr)
+            assert_allclose(pool.applyInverse(toArr), polyMap.applyInverse(toArr))
+
+    def test_evaluatorsAreReused(self):
+        """Check that calling a pool more than once does not rebuild
+        the native evaluators of each thread's PolyMap
+        """
+        polyMap = makeTwoWayPolyMap(2, 2)
+        pool = ast.MappingPool(polyMap, 4)
+        fromArr = np.random.uniform(-1, 1, size=(2, ast.MappingPool.MIN_POINTS_PER_THREAD * 4))
+
+        # the evaluators are built when first needed, one set per copy of the mapping
+        self.assertEqual(getPolyEvaluatorIds(pool), [0] * 8)
+        desToArr = pool.applyForward(fromArr)
+        idsAfterForward = getPolyEvaluatorIds(pool)
+        self.assertEqual(len(set(idsAfterForward)), 8)
+        self.assertNotIn(0, idsAfterForward)
+
+        assert_equal(pool.applyForward(fromArr), desToArr)
+        self.assertEqual(getPolyEvaluatorIds(pool), idsAfterForward)
+        pool.applyInverse(desToArr)
+        self.assertEqual(getPolyEvaluatorIds(pool), idsAfterForward)
+
+    def test_nanOutput(self):
+        """Check that AST__BAD is replaced with nan in every thread's output
+        """
+        nPts = ast.MappingPool.MIN_POINTS_PER_THREAD * 4
+        mathMap = ast.MathMap(1, 1, ["y = qif(x < 0, <bad>, x)"], ["x = y"])
+        pool = ast.MappingPool(mathMap, 4)
+        fromArr = np.array([np.linspace(-1, 1, nPts)])
+        toArr = pool.applyForward(fromArr)
+        isNeg = fromArr[0] < 0
+        self.assertTrue(np.all(np.isnan(toArr[0, isNeg])))
+        assert_equal(toArr[0, ~isNeg], fromArr[0, ~isNeg])
+
+    def test_copiesAreIndependent(self):
+        """Changing the original mapping does not affect the pool,
+        which keeps transforming points as the mapping did when the pool was made
+        """
+        nPts = ast.MappingPool.MIN_POINTS_PER_THREAD * 2  # enough to use both threads
+        fromArr = np.random.uniform(-1, 1, size=(2, nPts))
+
+        zoomMap = ast.ZoomMap(2, 1.3, "Invert=1")
+        pool = ast.MappingPool(zoomMap, 2)
+        zoomMap.clear("Invert")
+        self.assertFalse(zoomMap.isInverted)
+        assert_allclose(zoomMap.applyForward(fromArr), fromArr * 1.3)
+        assert_allclose(pool.applyForward(fromArr), fromArr / 1.3)
+        assert_allclose(pool.applyInverse(fromArr), fromArr * 1.3)
+
+        shift = [0.5, -1.5]
+        seriesMap = ast.SeriesMap(ast.ShiftMap(shift), ast.ZoomMap(2, 1.3), "Invert=1")
+        pool = ast.MappingPool(seriesMap, 2)
+        desToArr = seriesMap.applyForward(fromArr)
+        seriesMap.clear("Invert")
+        assert_allclose(seriesMap.applyForward(fromArr), (fromArr.T + shift).T * 1.3)
+        assert_allclose(pool.applyForward(fromArr), desToArr)
+
+if __name__ == "__main__":
+    unittest.main()
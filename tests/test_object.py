@@ -1,4 +1,7 @@
 import multiprocessing
+import subprocess
+import sys
+import threading
 import unittest
 
 import numpy as np
@@ -71,6 +74,87 @@ class TestObject(ObjectTestCase):
         self.assertEqual(obj.getRefCount(), 1)
         self.assertEqual(obj.getNObject(), initialNumObj)
 
+    def test_copyOnWrite(self):
+        """Test Object.setCopyOnWrite"""
+        self.assertFalse(ast.Object.getCopyOnWrite())
+        ast.Object.setCopyOnWrite(True)
+        try:
+            self.assertTrue(ast.Object.getCopyOnWrite())
+            obj = ast.ZoomMap(2, 1.3, "Ident=original")
+            initialNumObj = obj.getNObject()  # may be >1 when run using pytest
+
+            # a copy shares the AST object until one of them is modified
+            cp = obj.copy()
+            self.assertTrue(obj.same(cp))
+            self.assertEqual(obj.getRefCount(), 2)
+            self.assertEqual(obj.getNObject(), initialNumObj)
+            self.assertEqual(cp, obj)
+            cp2 = cp.copy()
+            self.assertEqual(obj.getRefCount(), 3)
+
+            cp.ident = "copy"
+            self.assertFalse(obj.same(cp))
+            self.assertEqual(cp.ident, "copy")
+            self.assertEqual(obj.ident, "original")
+            self.assertEqual(cp2.ident, "original")
+            self.assertEqual(cp.getRefCount(), 1)
+            self.assertEqual(obj.getRefCount(), 2)
+            self.assertEqual(obj.getNObject(), initialNumObj + 1)
+
+            # modifying the original leaves the copy unchanged
+            obj.ident = "modified"
+            self.assertEqual(cp2.ident, "original")
+            self.assertEqual(obj.getRefCount(), 1)
+            self.assertEqual(cp2.getRefCount(), 1)
+            del cp, cp2
+            self.assertEqual(obj.getNObject(), initialNumObj)
+
+            # an object with an ID is deep copied
+            obj.id = "initial_id"
+            cp = obj.copy()
+            self.assertFalse(obj.same(cp))
+            self.assertEqual(cp.id, "")
+
+            # an object shared with a compound object is deep copied,
+            # and then shares with its own copies
+            seriesMap = cp.then(cp)
+            cp2 = cp.copy()
+            self.assertFalse(cp.same(cp2))
+            self.assertEqual(cp.getRefCount(), 3)
+            cp3 = cp2.copy()
+            self.assertTrue(cp2.same(cp3))
+            del seriesMap
+
+            # a frame retrieved as a shallow copy affects only its own FrameSet
+            frameSet = ast.FrameSet(ast.Frame(2, "Ident=base"))
+            frameSetCopy = frameSet.copy()
+            self.assertTrue(frameSet.same(frameSetCopy))
+            frame = frameSet.getFrame(frameSet.BASE, copy=False)
+            frame.ident = "newBase"
+            self.assertEqual(frameSet.getFrame(frameSet.BASE).ident, "newBase")
+            self.assertEqual(frameSetCopy.getFrame(frameSet.BASE).ident, "base")
+            # ...and prevents further sharing of the FrameSet
+            frameSetCopy2 = frameSet.copy()
+            self.assertFalse(frameSet.same(frameSetCopy2))
+            frame.ident = "newerBase"
+            self.assertEqual(frameSetCopy2.getFrame(frameSet.BASE).ident, "newBase")
+
+            # modifying a component of a copy leaves the original unchanged
+            for compound in (ast.SeriesMap(ast.ZoomMap(2, 1.5, "Ident=zoom"), ast.UnitMap(2)),
+                             ast.CmpFrame(ast.Frame(2, "Ident=zoom"), ast.Frame(1))):
+                compoundCopy = compound.copy()
+                component = compoundCopy[0]
+                component.ident = "modified"
+                self.assertEqual(component.ident, "modified")
+                self.assertEqual(compound[0].ident, "zoom")
+        finally:
+            ast.Object.setCopyOnWrite(False)
+
+        # with copy-on-write disabled copies are deep again
+        obj = ast.ZoomMap(2, 1.3)
+        cp = obj.copy()
+        self.assertFalse(obj.same(cp))
+
     def test_error_handling(self):
         """Test handling of AST errors
         """
@@ -100,6 +184,35 @@ class TestObject(ObjectTestCase):
         except RuntimeError as e:
             self.assertEqual(e.args[0].count("Error"), 1)
 
+    def test_error_handling_threads(self):
+        """Test that AST errors in different threads are reported separately
+        """
+        coeff_f = np.array([
+            [1.2, 1, 2, 0],
+            [-0.5, 1, 1, 1],
+            [1.0, 2, 0, 1],
+        ])
+        indata = np.array([
+            [1.0, 2.0, 3.0],
+            [0.0, 1.0, 2.0],
+        ])
+        errorCounts = []
+
+        def causeError():
+            pm = ast.PolyMap(coeff_f, 2, "IterInverse=0")
+            for i in range(10):
+                try:
+                    pm.applyInverse(indata)
+                except RuntimeError as e:
+                    errorCounts.append(e.args[0].count("Error"))
+
+        threads = [threading.Thread(target=causeError) for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(errorCounts, [1]*40)
+
     def test_equality(self):
         """Test __eq__ and __ne__
         """
@@ -132,6 +245,91 @@ class TestObject(ObjectTestCase):
         frameSet3 = ast.FrameSet(frame3)
         self.assertNotEqual(frameSet1, frameSet3)
 
+        # objects of different classes, and one object compared to itself
+        self.assertNotEqual(zoomMap, ast.UnitMap(2))
+        self.assertEqual(zoomMap, zoomMap)
+
+        # objects whose text differs only in the last line or by an extra line
+        self.assertNotEqual(ast.ZoomMap(2, 1.5), ast.ZoomMap(2, 1.5, "Ident=extra"))
+        self.assertNotEqual(ast.ZoomMap(2, 1.5, "Ident=extra"), ast.ZoomMap(2, 1.5))
+
+        # stopping the write at the first difference leaves no AST error behind:
+        # later calls succeed, and errors report only their own messages
+        self.assertNotEqual(frameSet1, frameSet3)
+        self.assertEqual(frameSet1, frameSet1.copy())
+        with self.assertRaises(RuntimeError) as cm:
+            ast.ZoomMap(2, 0)
+        self.assertNotIn("astWrite", str(cm.exception))
+
+    def test_hash(self):
+        """Test that equal objects have equal hashes and can be deduplicated
+        """
+        frame = ast.Frame(2)
+        zoomMap = ast.ZoomMap(2, 1.5)
+        frameSet1 = ast.FrameSet(frame, zoomMap, frame)
+        frameSet2 = ast.FrameSet(frame, zoomMap, frame)
+        self.assertEqual(frameSet1.hash(), frameSet2.hash())
+        self.assertEqual(zoomMap.hash(), zoomMap.copy().hash())
+        self.assertNotEqual(zoomMap.hash(), ast.ZoomMap(2, 1.6).hash())
+
+        unique = {obj.hash(): obj for obj in (frameSet1, frameSet2, zoomMap, zoomMap.copy(),
+                                              ast.ZoomMap(2, 1.6))}
+        self.assertEqual(len(unique), 3)
+
+        # objects are mutable, so they are not hashable by Python
+        with self.assertRaises(TypeError):
+            hash(zoomMap)
+
+    def test_hashMutation(self):
+        """Test that the cached hash is updated when an object is modified
+        """
+        zoomMap = ast.ZoomMap(2, 1.5)
+        initialHash = zoomMap.hash()
+        copy = zoomMap.copy()
+        self.assertEqual(copy.hash(), initialHash)
+
+        zoomMap.ident = "modified"
+        self.assertNotEqual(zoomMap.hash(), initialHash)
+        self.assertNotEqual(zoomMap, copy)
+        self.assertEqual(copy.hash(), initialHash)
+
+        zoomMap.ident = ""
+        self.assertEqual(zoomMap.hash(), initialHash)
+        self.assertEqual(zoomMap, copy)
+
+    def test_equalityAfterShallowChange(self):
+        """Test that equality does not trust a hash made out of date by
+        a change through a shallow copy
+        """
+        frameSet1 = ast.FrameSet(ast.Frame(2, "Ident=base"))
+        frameSet2 = ast.FrameSet(ast.Frame(2, "Ident=changed"))
+        self.assertNotEqual(frameSet1.hash(), frameSet2.hash())
+        self.assertNotEqual(frameSet1, frameSet2)
+
+        frameSet1.getFrame(frameSet1.BASE, copy=False).ident = "changed"
+        self.assertEqual(frameSet1, frameSet2)
+        self.assertEqual(frameSet2, frameSet1)
+
+    def test_hashCopyWithID(self):
+        """Test that a copy does not keep the hash of an original with an ID,
+        since ID is not copied
+        """
+        zoomMap = ast.ZoomMap(2, 1.5, "ID=original")
+        initialHash = zoomMap.hash()
+        copy = zoomMap.copy()
+        self.assertEqual(copy.id, "")
+        self.assertNotEqual(copy.hash(), initialHash)
+        self.assertEqual(copy.hash(), ast.ZoomMap(2, 1.5).hash())
+
+    def test_hashStable(self):
+        """Test that the hash is the same in a different process
+        """
+        code = "import astshim as ast; print(ast.FrameSet(ast.Frame(2), ast.ZoomMap(2, 1.5), " \
+            "ast.Frame(2)).hash())"
+        output = subprocess.check_output([sys.executable, "-c", code])
+        frameSet = ast.FrameSet(ast.Frame(2), ast.ZoomMap(2, 1.5), ast.Frame(2))
+        self.assertEqual(int(output), frameSet.hash())
+
     def test_id(self):
         """Test that ID is *not* transferred to copies"""
         obj = ast.ZoomMap(2, 1.3)
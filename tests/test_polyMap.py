@@ -5,6 +5,7 @@ import numpy as np
 import numpy.testing as npt
 
 import astshim as ast
+from astshim.detail.testUtils import applyWithAst, getPolyEvaluatorIds
 from astshim.test import MappingTestCase
 
 
@@ -404,6 +405,64 @@ class TestPolyMap(MappingTestCase):
             result = cmp2.simplified()
             self.assertIsInstance(result, ast.UnitMap)
 
+    def test_PolyMapHighOrder(self):
+        """Test evaluation of a high order polynomial against numpy
+        and against AST itself, for many points, in both directions
+        and when inverted
+        """
+        rng = np.random.RandomState(5)
+        order = 7
+        coeffList = []
+        for out in (1, 2):
+            for i in range(order + 1):
+                for j in range(order + 1 - i):
+                    coeffList.append([rng.uniform(-1, 1), out, i, j])
+        coeff_f = np.array(coeffList)
+        # the inverse does not use output 1, which should be 0
+        coeff_i = np.array([
+            [-1.5, 2, 2, 1],
+            [0.5, 2, 0, 0],
+        ])
+        polyMap = ast.PolyMap(coeff_f, coeff_i)
+
+        def evalPoly(coeffs, nOut, indata):
+            outdata = np.zeros((nOut, indata.shape[1]))
+            for coeff in coeffs:
+                term = coeff[0] * np.ones(indata.shape[1])
+                for axis, power in enumerate(coeff[2:]):
+                    term *= indata[axis]**int(power)
+                outdata[int(coeff[1]) - 1] += term
+            return outdata
+
+        nPts = 10000  # more than one tile of points
+        indata = rng.uniform(-1.5, 1.5, size=(2, nPts))
+        indata[0, 7] = np.nan
+        indata[1, 5000] = np.nan
+        isBad = np.any(np.isnan(indata), axis=0)
+
+        desOutdata = evalPoly(coeff_f, 2, indata)
+        # both native evaluators are built when first needed, then reused
+        self.assertEqual(getPolyEvaluatorIds(polyMap), [0, 0])
+        outdata = polyMap.applyForward(indata)
+        evaluatorIds = getPolyEvaluatorIds(polyMap)
+        self.assertNotIn(0, evaluatorIds)
+        npt.assert_allclose(outdata, desOutdata, rtol=1e-13, atol=1e-13)
+        self.assertTrue(np.all(np.isnan(outdata[:, isBad])))
+        astOutdata = applyWithAst(polyMap, indata, True)
+        npt.assert_allclose(outdata[:, ~isBad], astOutdata[:, ~isBad], rtol=1e-13, atol=1e-13)
+
+        desIndata = evalPoly(coeff_i, 2, indata)
+        desIndata[:, isBad] = np.nan
+        inverseData = polyMap.applyInverse(indata)
+        self.assertEqual(getPolyEvaluatorIds(polyMap), evaluatorIds)
+        npt.assert_allclose(inverseData, desIndata, rtol=1e-13, atol=1e-13)
+        astInverseData = applyWithAst(polyMap, indata, False)
+        npt.assert_allclose(inverseData[:, ~isBad], astInverseData[:, ~isBad], rtol=1e-13, atol=1e-13)
+
+        invPolyMap = polyMap.inverted()
+        npt.assert_allclose(invPolyMap.applyForward(indata), inverseData)
+        npt.assert_allclose(invPolyMap.applyInverse(indata), outdata)
+
 
 if __name__ == "__main__":
     unittest.main()
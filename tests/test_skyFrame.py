@@ -1,6 +1,7 @@
 import math
 import unittest
 
+import numpy as np
 from numpy.testing import assert_allclose
 
 import astshim as ast
@@ -157,6 +158,57 @@ class TestSkyFrame(MappingTestCase):
         mapping = frame.skyOffsetMap()
         self.assertEqual(mapping.className, "UnitMap")
 
+    def test_SkyFrameGeometryArrays(self):
+        """Test the versions of the geometry methods for arrays of points
+        against the single point versions
+        """
+        frame = ast.SkyFrame()
+        rng = np.random.RandomState(5)
+        nPoints = 20
+        # (lon, lat) in radians, including longitudes outside [0, 2 pi] for norm
+        points1 = np.array([rng.uniform(-1, 8, nPoints), rng.uniform(-1.5, 1.5, nPoints)])
+        points2 = np.array([rng.uniform(0, 6, nPoints), rng.uniform(-1.5, 1.5, nPoints)])
+        points3 = np.array([rng.uniform(0, 6, nPoints), rng.uniform(-1.5, 1.5, nPoints)])
+        offsets = rng.uniform(-0.5, 0.5, nPoints)
+        angles = rng.uniform(-math.pi, math.pi, nPoints)
+
+        def pointList(points):
+            return [list(point) for point in points.T]
+
+        pts1, pts2, pts3 = pointList(points1), pointList(points2), pointList(points3)
+
+        distances = frame.distance(points1, points2)
+        self.assertEqual(distances.shape, (nPoints,))
+        assert_allclose(distances, [frame.distance(p1, p2) for p1, p2 in zip(pts1, pts2)])
+
+        assert_allclose(frame.angle(points1, points2, points3),
+                        [frame.angle(p1, p2, p3) for p1, p2, p3 in zip(pts1, pts2, pts3)])
+
+        assert_allclose(frame.axAngle(points1, points2, 2),
+                        [frame.axAngle(p1, p2, 2) for p1, p2 in zip(pts1, pts2)])
+
+        offsetPoints = frame.offset(points1, points2, offsets)
+        self.assertEqual(offsetPoints.shape, (2, nPoints))
+        assert_allclose(offsetPoints.T,
+                        [frame.offset(p1, p2, off) for p1, p2, off in zip(pts1, pts2, offsets)])
+
+        directions, offset2Points = frame.offset2(points1, angles, offsets)
+        desDirectionPoints = [frame.offset2(p1, angle, off) for p1, angle, off in zip(pts1, angles, offsets)]
+        assert_allclose(directions, [dp.direction for dp in desDirectionPoints])
+        assert_allclose(offset2Points.T, [dp.point for dp in desDirectionPoints])
+
+        normPoints = points1.copy()
+        frame.norm(normPoints)
+        assert_allclose(normPoints.T, [frame.norm(p1) for p1 in pts1])
+
+        # mismatched shapes are rejected
+        with self.assertRaises(ValueError):
+            frame.distance(points1, np.ascontiguousarray(points2[:, 1:]))
+        with self.assertRaises(ValueError):
+            frame.distance(np.zeros((3, nPoints)), np.zeros((3, nPoints)))
+        with self.assertRaises(ValueError):
+            frame.offset(points1, points2, offsets[1:])
+
 
 if __name__ == "__main__":
     unittest.main()